@@ -0,0 +1,66 @@
+// Timing helpers shared by the Node and browser benchmark entry points
+
+const now = () => performance.now()
+
+// Run fn repeatedly until minTimeMs has elapsed (at least minIterations, at most
+// maxIterations) after warmup calls, and summarize the per-call timings.
+// bytes, when given, is the payload per call and adds a throughput figure.
+export function measure(fn, { warmup = 3, minIterations = 5, maxIterations = 100000, minTimeMs = 250, bytes = 0 } = {}) {
+    for (let i = 0; i < warmup; i++) fn()
+
+    const samples = []
+    const start = now()
+    while (samples.length < maxIterations && (samples.length < minIterations || now() - start < minTimeMs)) {
+        const t0 = now()
+        fn()
+        samples.push(now() - t0)
+    }
+
+    return summarize(samples, bytes)
+}
+
+// Same as measure, but times batches of calls for operations shorter than the timer resolution
+export function measureBatched(fn, { batch = 1000, bytes = 0, ...options } = {}) {
+    const result = measure(() => {
+        for (let i = 0; i < batch; i++) fn()
+    }, { ...options, bytes: bytes * batch })
+
+    const scale = (value) => value / batch
+    return {
+        ...result,
+        iterations: result.iterations * batch,
+        meanMs: scale(result.meanMs),
+        medianMs: scale(result.medianMs),
+        p95Ms: scale(result.p95Ms),
+        minMs: scale(result.minMs),
+        maxMs: scale(result.maxMs),
+        opsPerSec: result.opsPerSec * batch
+    }
+}
+
+function summarize(samples, bytes) {
+    const sorted = [...samples].sort((a, b) => a - b)
+    const total = samples.reduce((sum, value) => sum + value, 0)
+    const mean = total / samples.length
+    const pick = (q) => sorted[Math.min(sorted.length - 1, Math.floor(q * sorted.length))]
+
+    const result = {
+        iterations: samples.length,
+        meanMs: mean,
+        medianMs: pick(0.5),
+        p95Ms: pick(0.95),
+        minMs: sorted[0],
+        maxMs: sorted[sorted.length - 1],
+        opsPerSec: mean > 0 ? 1000 / mean : Infinity
+    }
+
+    if (bytes) result.bytesPerSec = mean > 0 ? bytes * 1000 / mean : Infinity
+    return result
+}
+
+// Human-readable sizes for case names: 1KB, 64KB, 16MB, ...
+export function formatSize(bytes) {
+    if (bytes >= 1024 * 1024) return `${bytes / (1024 * 1024)}MB`
+    if (bytes >= 1024) return `${bytes / 1024}KB`
+    return `${bytes}B`
+}
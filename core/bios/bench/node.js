@@ -0,0 +1,65 @@
+#!/usr/bin/env node
+// Run the BIOS benchmarks against a built module under Node and print a JSON report.
+//
+//   node bench/node.js [--variant bios|bios.min|bios.threads] [--suite files,...]
+//                      [--max-file-size bytes] [--max-entries n] [--out report.json] [--quick]
+
+import { writeFile } from 'node:fs/promises'
+import { dirname, resolve } from 'node:path'
+import { fileURLToPath, pathToFileURL } from 'node:url'
+import { runBenchmarks } from './suites.js'
+
+const root = resolve(dirname(fileURLToPath(import.meta.url)), '..')
+
+function parseArgs(argv) {
+    const options = { variant: 'bios', out: null, suites: undefined, maxFileSize: undefined, maxEntries: undefined }
+    for (let i = 0; i < argv.length; i++) {
+        const arg = argv[i]
+        const value = () => argv[++i]
+        if (arg === '--variant') options.variant = value()
+        else if (arg === '--out') options.out = value()
+        else if (arg === '--suite') options.suites = value().split(',')
+        else if (arg === '--max-file-size') options.maxFileSize = Number(value())
+        else if (arg === '--max-entries') options.maxEntries = Number(value())
+        else if (arg === '--quick') {
+            options.maxFileSize = 1024 * 1024
+            options.maxEntries = 1000
+        } else throw new Error(`Unknown argument: ${arg}`)
+    }
+    return options
+}
+
+// The BIOS logs through console.* directly (emscripten_console_log); keep stdout for the report
+function silenceConsole() {
+    const saved = { log: console.log, warn: console.warn, error: console.error, info: console.info }
+    console.log = console.warn = console.error = console.info = () => {}
+    return () => Object.assign(console, saved)
+}
+
+const options = parseArgs(process.argv.slice(2))
+const modulePath = resolve(root, 'build/dist', `${options.variant}.js`)
+const { default: createBIOS } = await import(pathToFileURL(modulePath).href)
+
+const restore = silenceConsole()
+let report
+try {
+    const bios = await createBIOS()
+    report = await runBenchmarks(bios, {
+        suites: options.suites,
+        maxFileSize: options.maxFileSize,
+        maxEntries: options.maxEntries,
+        environment: {
+            runtime: 'node',
+            version: process.version,
+            platform: `${process.platform}-${process.arch}`,
+            variant: options.variant
+        },
+        onResult: (entry) => process.stderr.write(`${entry.group}/${entry.name}: ${entry.error ? `error ${entry.error}` : `${entry.medianMs.toFixed(4)}ms median`}\n`)
+    })
+} finally {
+    restore()
+}
+
+const json = JSON.stringify(report, null, 2)
+if (options.out) await writeFile(options.out, json + '\n')
+else process.stdout.write(json + '\n')
@@ -0,0 +1,71 @@
+#!/usr/bin/env node
+// Run the BIOS benchmarks in headless Chromium through Playwright and print the JSON report.
+// Playwright is optional and not a dependency of this package: pnpm add -D playwright
+//
+//   node bench/playwright.js [--variant bios|bios.min|bios.threads] [--suite files,...]
+//                            [--quick] [--out report.json] [--timeout ms]
+
+import { createServer } from 'node:http'
+import { readFile, writeFile } from 'node:fs/promises'
+import { dirname, extname, join, normalize, resolve } from 'node:path'
+import { fileURLToPath } from 'node:url'
+
+const root = resolve(dirname(fileURLToPath(import.meta.url)), '..')
+const types = { '.html': 'text/html', '.js': 'text/javascript', '.wasm': 'application/wasm', '.json': 'application/json' }
+
+const args = process.argv.slice(2)
+const flag = (name) => args.includes(name)
+const option = (name, fallback) => {
+    const index = args.indexOf(name)
+    return index >= 0 ? args[index + 1] : fallback
+}
+
+let chromium
+try {
+    ({ chromium } = await import('playwright'))
+} catch {
+    console.error('Playwright is not installed; run `pnpm add -D playwright && npx playwright install chromium`')
+    process.exit(1)
+}
+
+// Static server for the package root; COOP/COEP make the page cross-origin isolated
+// so the threads variant gets SharedArrayBuffer
+const server = createServer(async (request, response) => {
+    const path = normalize(decodeURIComponent(new URL(request.url, 'http://localhost').pathname))
+    try {
+        const body = await readFile(join(root, path))
+        response.writeHead(200, {
+            'Content-Type': types[extname(path)] || 'application/octet-stream',
+            'Cross-Origin-Opener-Policy': 'same-origin',
+            'Cross-Origin-Embedder-Policy': 'require-corp'
+        })
+        response.end(body)
+    } catch {
+        response.writeHead(404)
+        response.end()
+    }
+})
+await new Promise((done) => server.listen(0, '127.0.0.1', done))
+
+const query = new URLSearchParams({ variant: option('--variant', 'bios') })
+if (option('--suite')) query.set('suite', option('--suite'))
+if (flag('--quick')) query.set('quick', '1')
+
+const browser = await chromium.launch()
+try {
+    const page = await browser.newPage()
+    await page.goto(`http://127.0.0.1:${server.address().port}/bench/browser.html?${query}`)
+    await page.waitForFunction(() => window.__benchReport || window.__benchError, null, {
+        timeout: Number(option('--timeout', 600000))
+    })
+
+    const error = await page.evaluate(() => window.__benchError)
+    if (error) throw new Error(error)
+
+    const json = JSON.stringify(await page.evaluate(() => window.__benchReport), null, 2)
+    if (option('--out')) await writeFile(option('--out'), json + '\n')
+    else process.stdout.write(json + '\n')
+} finally {
+    await browser.close()
+    server.close()
+}
@@ -0,0 +1,258 @@
+// BIOS benchmark suites. Runs against an instantiated module in Node or a browser and
+// skips cases whose exports are missing, so older builds can be compared too.
+
+import { measure, measureBatched, formatSize } from './harness.js'
+import { createBindings } from '../src/bindings.js'
+
+export const FILE_SIZES = [1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 256 * 1024 * 1024]
+export const DIRECTORY_SIZES = [10, 1000, 50000]
+
+const encoder = new TextEncoder()
+const decoder = new TextDecoder()
+
+const has = (bios, name) => typeof bios[`_${name}`] === 'function'
+
+// NUL-terminated UTF-8 copy of a string in the WASM heap; caller frees
+function allocString(bios, value) {
+    const bytes = encoder.encode(value)
+    const ptr = bios._malloc(bytes.length + 1)
+    bios.HEAPU8.set(bytes, ptr)
+    bios.HEAPU8[ptr + bytes.length] = 0
+    return ptr
+}
+
+// Heap buffer of size bytes filled with printable ASCII (no NULs, so write_file works too)
+function allocPayload(bios, size) {
+    const ptr = bios._malloc(size + 1)
+    if (!ptr) throw new Error(`malloc(${size}) failed`)
+    const view = bios.HEAPU8.subarray(ptr, ptr + size)
+    for (let i = 0; i < size; i += 4096) view.fill(97 + (i / 4096) % 26, i, Math.min(size, i + 4096))
+    bios.HEAPU8[ptr + size] = 0
+    return ptr
+}
+
+function suiteDispatch(bios, record) {
+    if (!has(bios, 'execute_with_output')) return
+
+    const lenPtr = bios._malloc(4)
+    const commands = { echo: 'echo hello', unknown: 'nosuchcommand' }
+
+    for (const [name, command] of Object.entries(commands)) {
+        const commandPtr = allocString(bios, command)
+        record('dispatch', `execute_with_output/${name}`, { command }, measureBatched(() => {
+            const out = bios._execute_with_output(commandPtr, lenPtr)
+            if (out) bios._free(out)
+        }, { batch: 200 }))
+        bios._free(commandPtr)
+    }
+
+    if (has(bios, 'execute_result')) {
+        const commandPtr = allocString(bios, commands.echo)
+        record('dispatch', 'execute_result/echo', { command: commands.echo }, measureBatched(() => {
+            bios._execute_result(commandPtr)
+        }, { batch: 200 }))
+        bios._free(commandPtr)
+    }
+
+    bios._free(lenPtr)
+}
+
+function suiteFiles(bios, record, { maxFileSize }) {
+    const lenPtr = bios._malloc(4)
+    const pathPtr = allocString(bios, '/bench-file.bin')
+
+    for (const size of FILE_SIZES.filter((size) => size <= maxFileSize)) {
+        const label = formatSize(size)
+        const iterations = size >= 16 * 1024 * 1024 ? { warmup: 1, minIterations: 3, minTimeMs: 0 } : {}
+
+        let payload = 0
+        try {
+            payload = allocPayload(bios, size)
+
+            if (has(bios, 'write_file_bytes')) {
+                record('files', `write_file_bytes/${label}`, { size }, measure(() => {
+                    if (bios._write_file_bytes(pathPtr, payload, size) !== 0) throw new Error('write_file_bytes failed')
+                }, { ...iterations, bytes: size }))
+            }
+
+            // write_file scans for the terminating NUL, so this measures strlen + write
+            record('files', `write_file/${label}`, { size }, measure(() => {
+                if (bios._write_file(pathPtr, payload) !== 0) throw new Error('write_file failed')
+            }, { ...iterations, bytes: size }))
+
+            // Free the payload before reading so large sizes fit next to the result buffer
+            bios._free(payload)
+            payload = 0
+
+            record('files', `read_file/${label}`, { size }, measure(() => {
+                const ptr = bios._read_file(pathPtr, lenPtr)
+                if (!ptr) throw new Error('read_file failed')
+                bios._free(ptr)
+            }, { ...iterations, bytes: size }))
+
+            if (has(bios, 'read_file_result')) {
+                record('files', `read_file_result/${label}`, { size }, measure(() => {
+                    const ptr = bios._read_file_result(pathPtr)
+                    if (!ptr || bios.HEAP32[(ptr >> 2) + 1] !== 0) throw new Error('read_file_result failed')
+                }, { ...iterations, bytes: size }))
+            }
+        } catch (err) {
+            record('files', `file/${label}`, { size }, { error: String(err.message || err) })
+        } finally {
+            if (payload) bios._free(payload)
+            bios._delete_file(pathPtr)
+        }
+    }
+
+    bios._free(pathPtr)
+    bios._free(lenPtr)
+}
+
+// Flat directories of empty files, created through FS when the build exports it
+function createTree(bios, root, count) {
+    if (bios.FS) {
+        bios.FS.mkdirTree(root)
+        for (let i = 0; i < count; i++) bios.FS.writeFile(`${root}/file-${i}.txt`, '')
+        return
+    }
+
+    const empty = allocString(bios, '')
+    for (let i = 0; i < count; i++) {
+        const path = allocString(bios, `${root}/file-${i}.txt`)
+        bios._write_file(path, empty)
+        bios._free(path)
+    }
+    bios._free(empty)
+}
+
+function suiteDirectories(bios, record, { maxEntries }) {
+    if (!has(bios, 'list_directory')) return
+    const lenPtr = bios._malloc(4)
+    const emptyPtr = allocString(bios, '')
+
+    for (const count of DIRECTORY_SIZES.filter((count) => count <= maxEntries)) {
+        const root = `/bench-dir-${count}`
+        try {
+            createTree(bios, root, count)
+        } catch (err) {
+            record('directories', `create/${count}`, { entries: count }, { error: String(err.message || err) })
+            continue
+        }
+
+        const rootPtr = allocString(bios, root)
+        const options = count >= 50000 ? { warmup: 1, minIterations: 3 } : {}
+
+        record('directories', `list_directory/${count}`, { entries: count }, measure(() => {
+            const ptr = bios._list_directory(rootPtr, lenPtr)
+            if (ptr) bios._free(ptr)
+        }, options))
+
+        if (has(bios, 'list_directory_result')) {
+            record('directories', `list_directory_result/${count}`, { entries: count }, measure(() => {
+                bios._list_directory_result(rootPtr)
+            }, options))
+        }
+
+        if (has(bios, 'list_directory_ex')) {
+            record('directories', `list_directory_ex/${count}`, { entries: count }, measure(() => {
+                const ptr = bios._list_directory_ex(rootPtr, -1, emptyPtr, lenPtr)
+                if (ptr) bios._free(ptr)
+            }, options))
+        }
+
+        bios._free(rootPtr)
+    }
+
+    bios._free(emptyPtr)
+    bios._free(lenPtr)
+}
+
+function suiteMarshalling(bios, record) {
+    const path = '/bench-missing-file'
+    const pathPtr = allocString(bios, path)
+
+    // Bare JS -> WASM call with no arguments to convert
+    record('marshalling', 'call/get_last_status', {}, measureBatched(() => bios._get_last_status()))
+
+    // The same export with a pre-encoded path, through the bindings, cwrap and ccall
+    const fileExists = bios.cwrap ? bios.cwrap('file_exists', 'number', ['string']) : null
+    const bindings = createBindings(bios)
+    record('marshalling', 'file_exists/pointer', {}, measureBatched(() => bios._file_exists(pathPtr)))
+    if (bindings.fileExists) {
+        record('marshalling', 'file_exists/bindings', {}, measureBatched(() => bindings.fileExists(path)))
+        const unicode = '/bench-missing-fïle'
+        record('marshalling', 'file_exists/bindings-utf8', {}, measureBatched(() => bindings.fileExists(unicode)))
+    }
+    if (fileExists) record('marshalling', 'file_exists/cwrap', {}, measureBatched(() => fileExists(path)))
+    if (bios.ccall) {
+        record('marshalling', 'file_exists/ccall', {}, measureBatched(() => bios.ccall('file_exists', 'number', ['string'], [path])))
+    }
+
+    // Moving strings across the boundary by hand
+    for (const size of [16, 1024, 64 * 1024]) {
+        const text = 'x'.repeat(size)
+        const ptr = bios._malloc(size * 3 + 1)
+        const batch = size >= 64 * 1024 ? 20 : 1000
+
+        record('marshalling', `encodeInto/${formatSize(size)}`, { size },
+            measureBatched(() => encoder.encodeInto(text, bios.HEAPU8.subarray(ptr, ptr + size * 3)), { batch, bytes: size }))
+
+        bios.HEAPU8.fill(120, ptr, ptr + size)
+        record('marshalling', `decode/${formatSize(size)}`, { size },
+            measureBatched(() => decoder.decode(bios.HEAPU8.subarray(ptr, ptr + size)), { batch, bytes: size }))
+
+        bios._free(ptr)
+    }
+
+    bindings.dispose()
+    bios._free(pathPtr)
+}
+
+export const SUITES = {
+    dispatch: suiteDispatch,
+    files: suiteFiles,
+    directories: suiteDirectories,
+    marshalling: suiteMarshalling
+}
+
+// Run the selected suites and return the JSON report
+export async function runBenchmarks(bios, {
+    suites = Object.keys(SUITES),
+    maxFileSize = FILE_SIZES[FILE_SIZES.length - 1],
+    maxEntries = DIRECTORY_SIZES[DIRECTORY_SIZES.length - 1],
+    environment = {},
+    onResult = () => {}
+} = {}) {
+    const results = []
+    const record = (group, name, params, stats) => {
+        const entry = { group, name, params, ...stats }
+        results.push(entry)
+        onResult(entry)
+    }
+
+    if (has(bios, 'init')) bios._init()
+    if (has(bios, 'reset_metrics')) bios._reset_metrics()
+
+    for (const name of suites) {
+        const suite = SUITES[name]
+        if (!suite) throw new Error(`Unknown suite: ${name}`)
+        suite(bios, record, { maxFileSize, maxEntries })
+    }
+
+    let metrics = null
+    if (has(bios, 'get_metrics')) {
+        const ptr = bios._get_metrics()
+        const length = bios.HEAP32[ptr >> 2]
+        metrics = JSON.parse(decoder.decode(bios.HEAPU8.subarray(ptr + 16, ptr + 16 + length)))
+    }
+
+    return {
+        schema: 1,
+        package: '@ecmaos/bios',
+        timestamp: new Date().toISOString(),
+        environment,
+        exports: Object.keys(bios).filter((key) => key.startsWith('_') && typeof bios[key] === 'function').sort(),
+        results,
+        metrics
+    }
+}
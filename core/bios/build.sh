@@ -4,8 +4,15 @@ if [ -n "$SKIP_BUILD_BIOS" ]; then
   exit 0
 fi
 
-# Ensure EMSDK is set
-if [ -z "$EMSDK" ]; then
+# Variants to build: "release" (bios.js, -O3/LTO/SIMD), "minsize" (bios.min.js, -Oz/Closure),
+# "threads" (bios.threads.js, release + pthread worker pool; opt-in) and "wasi"
+# (bios.wasi.wasm, the command core for WASI runtimes; opt-in, needs WASI_SDK_PATH and
+# WASI_ZLIB_PREFIX pointing at a zlib built for WASI)
+BIOS_VARIANTS=${BIOS_VARIANTS:-"release minsize"}
+DIST_DIR="$(pwd)/build/dist"
+
+# Ensure EMSDK is set when any Emscripten variant is requested
+if [ -z "$EMSDK" ] && [ -n "$(echo "$BIOS_VARIANTS" | tr ' ' '\n' | grep -v '^wasi$')" ]; then
   # echo "Error: EMSDK environment variable not set"
   # echo "Please install and activate emscripten first"
   # exit 1
@@ -13,10 +20,40 @@ if [ -z "$EMSDK" ]; then
   exit 0
 fi
 
-mkdir -p build
-cd build
+build_variant() {
+  local build_dir=$1
+  local build_type=$2
+  local output_name=$3
+  shift 3
+
+  mkdir -p "build/$build_dir"
+  (
+    cd "build/$build_dir" || exit 1
+    emcmake cmake ../.. -DCMAKE_BUILD_TYPE="$build_type" -DBIOS_OUTPUT_NAME="$output_name" -DBIOS_DIST_DIR="$DIST_DIR" "$@" &&
+    emmake make
+  ) || exit 1
+}
+
+build_wasi() {
+  if [ -z "$WASI_SDK_PATH" ]; then
+    echo "WASI_SDK_PATH not set, skipping wasi variant"
+    return 0
+  fi
+
+  cmake -S . -B build/wasi -DCMAKE_BUILD_TYPE=Release -DBIOS_DIST_DIR="$DIST_DIR" \
+    -DCMAKE_TOOLCHAIN_FILE="$WASI_SDK_PATH/share/cmake/wasi-sdk.cmake" \
+    -DCMAKE_PREFIX_PATH="$WASI_ZLIB_PREFIX" &&
+  cmake --build build/wasi || exit 1
+}
 
-emcmake cmake ..
-emmake make
+for variant in $BIOS_VARIANTS; do
+  case "$variant" in
+    release) build_variant release Release bios ;;
+    minsize) build_variant minsize MinSizeRel bios.min ;;
+    threads) build_variant threads Release bios.threads -DBIOS_PTHREADS=ON ;;
+    wasi) build_wasi ;;
+    *) echo "Unknown BIOS variant: $variant"; exit 1 ;;
+  esac
+done
 
 echo "Build complete! Output files in build/dist/"
@@ -0,0 +1,65 @@
+// Direct-call bindings over a BIOSModule (see bindings.js). String arguments are encoded
+// into a persistent scratch buffer instead of going through ccall; numbers are passed
+// through and results are the export's own return values. Each binding is undefined when
+// the module lacks its export.
+declare module '@ecmaos/bios/bindings' {
+  import type { BIOSModule } from '@ecmaos/bios'
+
+  export type BIOSArgType = 'string' | 'bytes' | 'number'
+
+  export interface BIOSResult {
+    status: number
+    // View into HEAPU8, overwritten by the next *_result call
+    data: Uint8Array
+  }
+
+  export interface BIOSResultText {
+    status: number
+    text: string
+  }
+
+  export interface BIOSBindings {
+    getVersion(): string
+    execute(command: string): number
+    executeWithOutput(command: string, outLenPtr: number): number
+    executeResult(command: string): number
+    executeStreaming(command: string): number
+    executeAsync(command: string): number
+    writeFile(path: string, content: string): number
+    writeFileBytes(path: string, data: Uint8Array): number
+    appendFileBytes(path: string, data: Uint8Array): number
+    readFileResult(path: string): number
+    fileSize(path: string): number
+    readFileInto(path: string, bufferPtr: number, capacity: number): number
+    readFileRange(path: string, offset: number, length: number, outLenPtr: number): number
+    openReader(path: string): number
+    handleOpen(path: string, flags: number): number
+    lazyMount(path: string, size: number): number
+    lazyUnmount(path: string): number
+    // null clears the whole cache
+    blockCacheInvalidate(path: string | null): number
+    fileExists(path: string): number
+    deleteFile(path: string): number
+    listDirectoryResult(path: string): number
+    listDirectoryEx(path: string, depth: number, glob: string, outLenPtr: number): number
+    fsSnapshot(root: string): number
+    fsRestore(image: Uint8Array, root: string): number
+    // One _exists_many call for every path
+    existsMany(paths: string[]): boolean[]
+
+    // Decoders for pointers returned by the *_result bindings
+    readResult(ptr: number): BIOSResult
+    readResultText(ptr: number): BIOSResultText
+    // Free the scratch buffer; the bindings must not be used afterwards
+    dispose(): void
+  }
+
+  // Export name -> argument types that the bindings are built from
+  export const SPEC: Readonly<Record<string, readonly BIOSArgType[]>>
+  export const STRING_RETURNS: ReadonlySet<string>
+
+  export function createBindings(bios: BIOSModule): BIOSBindings
+  export function readString(bios: BIOSModule, ptr: number): string
+  export function readResult(bios: BIOSModule, ptr: number): BIOSResult
+  export function readResultText(bios: BIOSModule, ptr: number): BIOSResultText
+}
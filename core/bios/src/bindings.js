@@ -0,0 +1,255 @@
+// Direct-call bindings for the BIOS exports. Each binding calls its _export directly and
+// encodes string arguments into one persistent scratch buffer. This skips the stack
+// allocation, fresh string conversion and type-array dispatch that ccall does on every call.
+//
+//   import createBIOS from '@ecmaos/bios'
+//   import { createBindings } from '@ecmaos/bios/bindings'
+//   const bindings = createBindings(await createBIOS())
+//   bindings.fileExists('/etc/hosts')
+
+const encoder = new TextEncoder()
+const decoder = new TextDecoder()
+
+// Strings up to this length are first copied by charCode, which beats encodeInto for
+// short ASCII paths; anything else falls through to encodeInto
+const ASCII_FAST_PATH = 256
+
+// Binding table: export name -> argument types. Types are:
+//   'string'  JS string, passed as a NUL-terminated UTF-8 pointer (null/undefined -> 0)
+//   'bytes'   Uint8Array, passed as (pointer, length)
+//   'number'  passed through
+// Each binding is named after its export in camelCase and returns the export's number,
+// except names in STRING_RETURNS, which decode a returned C string. Exports that only take
+// numbers need no marshalling; call them on the module directly.
+export const SPEC = {
+    get_version: [],
+    execute: ['string'],
+    execute_with_output: ['string', 'number'],
+    execute_result: ['string'],
+    execute_streaming: ['string'],
+    execute_async: ['string'],
+    write_file: ['string', 'string'],
+    write_file_bytes: ['string', 'bytes'],
+    append_file_bytes: ['string', 'bytes'],
+    read_file_result: ['string'],
+    file_size: ['string'],
+    read_file_into: ['string', 'number', 'number'],
+    read_file_range: ['string', 'number', 'number', 'number'],
+    open_reader: ['string'],
+    handle_open: ['string', 'number'],
+    lazy_mount: ['string', 'number'],
+    lazy_unmount: ['string'],
+    block_cache_invalidate: ['string'],
+    file_exists: ['string'],
+    delete_file: ['string'],
+    list_directory_result: ['string'],
+    list_directory_ex: ['string', 'number', 'string', 'number'],
+    fs_snapshot: ['string'],
+    fs_restore: ['bytes', 'string']
+}
+
+export const STRING_RETURNS = new Set(['get_version'])
+
+const camelCase = (name) => name.replace(/_([a-z])/g, (_, letter) => letter.toUpperCase())
+
+// Heap ranges backed by a SharedArrayBuffer (threads build) cannot be decoded in place
+function decodeHeap(heap, start, end) {
+    const view = heap.subarray(start, end)
+    return decoder.decode(heap.buffer instanceof ArrayBuffer ? view : view.slice())
+}
+
+// Worst-case scratch bytes for an argument: 3 UTF-8 bytes per UTF-16 unit plus the NUL
+function argumentSize(type, value) {
+    if (type === 'string') return value == null ? 0 : String(value).length * 3 + 1
+    if (type === 'bytes') return value.length
+    return 0
+}
+
+// Write value at ptr as NUL-terminated UTF-8; returns the bytes used
+function writeString(heap, value, ptr) {
+    const length = value.length
+    if (length <= ASCII_FAST_PATH) {
+        let i = 0
+        for (; i < length; i++) {
+            const code = value.charCodeAt(i)
+            if (code >= 0x80) break
+            heap[ptr + i] = code
+        }
+        if (i === length) {
+            heap[ptr + length] = 0
+            return length + 1
+        }
+    }
+
+    const { written } = encoder.encodeInto(value, heap.subarray(ptr, ptr + length * 3))
+    heap[ptr + written] = 0
+    return written + 1
+}
+
+// One malloc'd buffer holding the arguments of the call in flight. Calls made from inside
+// another one (say from onOutput during _execute_streaming) stack above the outer call's
+// arguments, or take a temporary block when they do not fit. This way the outer call's
+// arguments never move under it. Arguments above SCRATCH_LIMIT (a large writeFileBytes,
+// say) get a one-off block, so the scratch buffer never pins more heap than that.
+const SCRATCH_LIMIT = 1024 * 1024
+
+function createScratch(bios) {
+    let base = 0
+    let size = 0
+    let used = 0
+
+    return {
+        claim(bytes) {
+            bytes = (bytes + 7) & ~7
+            if (used === 0 && bytes > size && bytes <= SCRATCH_LIMIT) {
+                if (base) bios._free(base)
+                size = Math.min(Math.max(bytes, size * 2, 4096), SCRATCH_LIMIT)
+                base = bios._malloc(size)
+                if (!base) {
+                    size = 0
+                    throw new Error(`bindings: scratch allocation of ${bytes} bytes failed`)
+                }
+            }
+            if (used + bytes <= size) {
+                const ptr = base + used
+                used += bytes
+                return ptr
+            }
+
+            const ptr = bios._malloc(bytes)
+            if (!ptr) throw new Error(`bindings: allocation of ${bytes} bytes failed`)
+            return ptr
+        },
+
+        release(ptr, bytes) {
+            if (ptr >= base && ptr < base + size) used -= (bytes + 7) & ~7
+            else bios._free(ptr)
+        },
+
+        dispose() {
+            if (base) bios._free(base)
+            base = size = used = 0
+        }
+    }
+}
+
+function bindExport(bios, scratch, name, types) {
+    const fn = bios[`_${name}`]
+    if (typeof fn !== 'function') return undefined
+    const returnsString = STRING_RETURNS.has(name)
+
+    // Hot shape (file_exists, file_size, execute, ...): one string in, a number out
+    if (types.length === 1 && types[0] === 'string' && !returnsString) {
+        return (value) => {
+            if (value == null) return fn(0)
+            value = String(value)
+            const bytes = value.length * 3 + 1
+            const ptr = scratch.claim(bytes)
+            try {
+                writeString(bios.HEAPU8, value, ptr)
+                return fn(ptr)
+            } finally {
+                scratch.release(ptr, bytes)
+            }
+        }
+    }
+
+    return (...values) => {
+        let bytes = 0
+        for (let i = 0; i < types.length; i++) bytes += argumentSize(types[i], values[i])
+
+        const ptr = bytes ? scratch.claim(bytes) : 0
+        try {
+            // Read HEAPU8 after claiming: a malloc may have grown memory and replaced it
+            const heap = bios.HEAPU8
+            const args = []
+            let cursor = ptr
+            for (let i = 0; i < types.length; i++) {
+                const value = values[i]
+                if (types[i] === 'string') {
+                    if (value == null) {
+                        args.push(0)
+                    } else {
+                        args.push(cursor)
+                        cursor += writeString(heap, String(value), cursor)
+                    }
+                } else if (types[i] === 'bytes') {
+                    heap.set(value, cursor)
+                    args.push(cursor, value.length)
+                    cursor += value.length
+                } else {
+                    args.push(value)
+                }
+            }
+
+            const result = fn(...args)
+            return returnsString ? readString(bios, result) : result
+        } finally {
+            if (bytes) scratch.release(ptr, bytes)
+        }
+    }
+}
+
+// Decode a NUL-terminated UTF-8 string from the heap
+export function readString(bios, ptr) {
+    if (!ptr) return ''
+    const heap = bios.HEAPU8
+    const end = heap.indexOf(0, ptr)
+    return decodeHeap(heap, ptr, end < 0 ? heap.length : end)
+}
+
+// Decode a *_result region: header [length, status, capacity, reserved] then data. data is
+// a view into HEAPU8 that the next *_result call overwrites; copy it to keep it.
+export function readResult(bios, ptr) {
+    if (!ptr) return { status: -1, data: new Uint8Array(0) }
+    const length = bios.HEAP32[ptr >> 2]
+    const status = bios.HEAP32[(ptr >> 2) + 1]
+    return { status, data: bios.HEAPU8.subarray(ptr + 16, ptr + 16 + length) }
+}
+
+// Same as readResult, with the data decoded as UTF-8
+export function readResultText(bios, ptr) {
+    if (!ptr) return { status: -1, text: '' }
+    const length = bios.HEAP32[ptr >> 2]
+    const status = bios.HEAP32[(ptr >> 2) + 1]
+    return { status, text: decodeHeap(bios.HEAPU8, ptr + 16, ptr + 16 + length) }
+}
+
+export function createBindings(bios) {
+    const scratch = createScratch(bios)
+    const bindings = {}
+
+    for (const [name, types] of Object.entries(SPEC)) {
+        const binding = bindExport(bios, scratch, name, types)
+        if (binding) bindings[camelCase(name)] = binding
+    }
+
+    // All paths in one call: NUL-separated in scratch, answered as a bitmap
+    if (typeof bios._exists_many === 'function') {
+        bindings.existsMany = (paths) => {
+            let bytes = 0
+            for (const path of paths) bytes += String(path).length * 3 + 1
+            if (bytes === 0) return []
+
+            const ptr = scratch.claim(bytes)
+            let status, bitmap
+            try {
+                const heap = bios.HEAPU8
+                let cursor = ptr
+                for (const path of paths) cursor += writeString(heap, String(path), cursor)
+                ;({ status, data: bitmap } = readResult(bios, bios._exists_many(ptr, cursor - ptr)))
+            } finally {
+                scratch.release(ptr, bytes)
+            }
+
+            const exists = new Array(paths.length).fill(false)
+            for (let i = 0; i < status && i < paths.length; i++) exists[i] = (bitmap[i >> 3] >> (i & 7) & 1) === 1
+            return exists
+        }
+    }
+
+    bindings.readResult = (ptr) => readResult(bios, ptr)
+    bindings.readResultText = (ptr) => readResultText(bios, ptr)
+    bindings.dispose = () => scratch.dispose()
+    return bindings
+}
@@ -2,12 +2,19 @@
 #include <string>
 #include <emscripten/console.h>
 #include "commands/commands.hpp"
-#include <fstream>
-#include <ios>
+#include "fs/fs.hpp"
+#include "kernels/compress.hpp"
+#include "kernels/kernels.hpp"
+#include "runtime/completions.hpp"
+#include "runtime/jobs.hpp"
+#include "runtime/metrics.hpp"
+#include "runtime/result.hpp"
 #include <sys/types.h>
 #include <sys/stat.h>
-#include <dirent.h>
 #include <cstring>
+#include <fnmatch.h>
+#include <memory>
+#include <vector>
 
 extern "C" {
     enum class KernelState {
@@ -16,11 +23,33 @@ extern "C" {
         PANIC
     };
 
-    static int last_status = 0;
+    // Status of the last synchronous execute* call on this thread; async jobs
+    // report per-job status through the completion ring instead
+    static thread_local int last_status = 0;
 
-    // Initialize kernel and return state
+    // Page source for lazy mounts: Module.lazyRead(path, offset, length) returns a
+    // Uint8Array (or null on failure). Proxied to the main thread under pthreads.
+    static int64_t fetch_lazy_page(const char* path, int64_t offset, size_t len, uint8_t* dest) {
+        return MAIN_THREAD_EM_ASM_INT({
+            var read = Module['lazyRead'];
+            var bytes = read ? read(UTF8ToString($0), $1, $2) : null;
+            if (!bytes) return -1;
+            var n = Math.min(bytes.length, $2);
+            HEAPU8.set(bytes.subarray(0, n), $3);
+            return n;
+        }, path, static_cast<double>(offset), len, dest);
+    }
+
+    // Call counters and latency for an export, resolved once into a function-local static
+    static runtime::Metric& export_metric(const char* name) {
+        return runtime::metric(runtime::MetricKind::Export, name);
+    }
+
+    // Initialize kernel and return state. Subsystems (metrics, caches, the worker pool)
+    // set themselves up on first use, so this adds nothing to time-to-first-command.
     EMSCRIPTEN_KEEPALIVE
     int init() {
+        fs::set_page_source(fetch_lazy_page);
         emscripten_console_log("Kernel initializing...");
         emscripten_console_warn("This is an experimental WASM kernel");
         return static_cast<int>(KernelState::RUNNING);
@@ -37,10 +66,13 @@ extern "C" {
     // Execute a command in the WASM kernel
     EMSCRIPTEN_KEEPALIVE
     int execute(const char* command) {
+        static runtime::Metric& metric = export_metric("execute");
+        runtime::MetricScope scope(metric);
         if (command && *command) {  // Check if command is valid and not empty
             // emscripten_console_log(command);
-            std::string cmd(command);  // Create a proper C++ string
-            const auto result = commands::execute_command(cmd);
+            const auto result = commands::execute_command(command);
+            scope.add_bytes_in(strlen(command));
+            scope.add_bytes_out(result.output.size());
             last_status = result.code;
             return result.code;
         }
@@ -51,6 +83,8 @@ extern "C" {
 
     EMSCRIPTEN_KEEPALIVE
     char* execute_with_output(const char* command, int* out_len) {
+        static runtime::Metric& metric = export_metric("execute_with_output");
+        runtime::MetricScope scope(metric);
         if (!out_len) return nullptr;
         *out_len = 0;
 
@@ -59,9 +93,10 @@ extern "C" {
             return nullptr;
         }
 
-        std::string cmd(command);
-        const auto result = commands::execute_command(cmd);
+        const auto result = commands::execute_command(command);
         last_status = result.code;
+        scope.add_bytes_in(strlen(command));
+        scope.add_bytes_out(result.output.size());
 
         if (result.output.empty()) return nullptr;
 
@@ -74,30 +109,263 @@ extern "C" {
         return buffer;
     }
 
+    // Writes command output straight into the shared result region
+    class ResultSink : public commands::OutputSink {
+    public:
+        explicit ResultSink(runtime::ResultBuffer& buffer) : buffer(buffer) {
+            ok = buffer.prepare(0) != nullptr;
+        }
+
+        void write(std::string_view data) override {
+            if (!ok || data.empty()) return;
+            char* out = buffer.grow(length + data.size());
+            if (!out) {
+                ok = false;
+                return;
+            }
+            memcpy(out + length, data.data(), data.size());
+            length += data.size();
+        }
+
+        runtime::ResultHeader* finish(int status) {
+            return ok ? buffer.finish(status, length) : nullptr;
+        }
+
+        size_t size() const { return length; }
+
+    private:
+        runtime::ResultBuffer& buffer;
+        size_t length = 0;
+        bool ok = false;
+    };
+
+    // Execute a command into the shared result region; no malloc and nothing for JS to free.
+    // Returns the region header (length, status = exit code) with the output right after it.
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* execute_result(const char* command) {
+        static runtime::Metric& metric = export_metric("execute_result");
+        runtime::MetricScope scope(metric);
+        ResultSink sink(runtime::result_buffer());
+        if (!(command && *command)) {
+            last_status = -1;
+            return sink.finish(-1);
+        }
+
+        last_status = commands::execute_command(command, sink);
+        scope.add_bytes_in(strlen(command));
+        scope.add_bytes_out(sink.size());
+        return sink.finish(last_status);
+    }
+
+    // Flush a chunk of streamed output to Module.onOutput; the view is only valid during the call
+    EM_JS(void, emit_output_chunk, (const char* data, int len), {
+        if (Module['onOutput']) Module['onOutput'](HEAPU8.subarray(data, data + len));
+    });
+
+    static void flush_to_js(const char* data, size_t len, void*) {
+        emit_output_chunk(data, static_cast<int>(len));
+    }
+
+    // Execute a command and stream its output to Module.onOutput in chunks as it is produced
+    EMSCRIPTEN_KEEPALIVE
+    int execute_streaming(const char* command) {
+        static runtime::Metric& metric = export_metric("execute_streaming");
+        runtime::MetricScope scope(metric);
+        if (!(command && *command)) {
+            last_status = -1;
+            return -1;
+        }
+
+        scope.add_bytes_in(strlen(command));
+        commands::ChunkedSink sink(flush_to_js);
+        last_status = commands::execute_command(command, sink);
+        sink.flush();
+        return last_status;
+    }
+
+    // Execute a newline- or NUL-separated list of commands in one call.
+    // The packed result is [int32 count] followed by one record per command:
+    // [int32 code][int32 length][output bytes], each record padded to 4 bytes.
+    EMSCRIPTEN_KEEPALIVE
+    char* execute_batch(const char* commands_list, int len, int* out_len) {
+        static runtime::Metric& metric = export_metric("execute_batch");
+        runtime::MetricScope scope(metric);
+        if (!out_len) return nullptr;
+        *out_len = 0;
+        if (!commands_list || len < 0) return nullptr;
+        scope.add_bytes_in(static_cast<size_t>(len));
+
+        std::string packed(sizeof(int32_t), '\0');
+        int32_t count = 0;
+
+        const char* cursor = commands_list;
+        const char* end = commands_list + len;
+        while (cursor < end) {
+            const char* stop = cursor;
+            while (stop < end && *stop != '\n' && *stop != '\0') ++stop;
+
+            const char* line_end = stop;
+            if (line_end > cursor && line_end[-1] == '\r') --line_end;
+
+            if (line_end > cursor) {
+                const auto result = commands::execute_command(std::string_view(cursor, line_end - cursor));
+                last_status = result.code;
+
+                int32_t header[2] = {
+                    result.code,
+                    static_cast<int32_t>(result.output.size())
+                };
+                packed.append(reinterpret_cast<const char*>(header), sizeof(header));
+                packed.append(result.output);
+                packed.append((4 - result.output.size() % 4) % 4, '\0');
+                ++count;
+            }
+
+            cursor = stop + 1;
+        }
+
+        memcpy(&packed[0], &count, sizeof(count));
+
+        char* buffer = (char*)malloc(packed.size());
+        if (!buffer) return nullptr;
+
+        memcpy(buffer, packed.data(), packed.size());
+        *out_len = static_cast<int>(packed.size());
+        scope.add_bytes_out(packed.size());
+        return buffer;
+    }
+
     EMSCRIPTEN_KEEPALIVE
     int get_last_status() {
         return last_status;
     }
 
+    // Notify Module.onJobComplete(id, code) on the main thread, after the current call returns
+    static void notify_completion(int id, int code) {
+        runtime::push_completion(id, code);
+        MAIN_THREAD_ASYNC_EM_ASM({
+            var callback = Module['onJobComplete'];
+            if (callback) setTimeout(function() { callback($0, $1); }, 0);
+        }, id, code);
+    }
+
+    // Run a command as a job on the worker pool (inline in single-threaded builds) and
+    // return its id. Completion is reported through completion_ring() and Module.onJobComplete;
+    // the result is then read with wait_job/job_output and dropped with release_job.
+    EMSCRIPTEN_KEEPALIVE
+    int execute_async(const char* command) {
+        static runtime::Metric& metric = export_metric("execute_async");
+        runtime::MetricScope scope(metric);
+        if (!(command && *command)) return -1;
+        scope.add_bytes_in(strlen(command));
+
+        return runtime::submit_job([cmd = std::string(command)](std::string& output) {
+            commands::StringSink sink;
+            int code = commands::execute_command(cmd, sink);
+            output = std::move(sink.output);
+            return code;
+        }, notify_completion);
+    }
+
+    // Address of the job completion ring (layout in runtime/completions.hpp)
+    EMSCRIPTEN_KEEPALIVE
+    runtime::CompletionRing* completion_ring() {
+        return &runtime::completion_ring();
+    }
+
+    // Job state (see runtime::JobState): -1 unknown, 0 pending, 1 running, 2 done
+    EMSCRIPTEN_KEEPALIVE
+    int poll_job(int id) {
+        return static_cast<int>(runtime::poll_job(id));
+    }
+
+    // Block until a job finishes and return its exit code (immediately for finished jobs).
+    // On the browser main thread this spins, so prefer the completion ring there.
+    EMSCRIPTEN_KEEPALIVE
+    int wait_job(int id) {
+        return runtime::wait_job(id);
+    }
+
+    // Output of a finished job; the pointer stays valid until release_job
+    EMSCRIPTEN_KEEPALIVE
+    const char* job_output(int id, int* out_len) {
+        if (!out_len) return nullptr;
+        *out_len = 0;
+
+        const std::string* output = runtime::job_output(id);
+        if (!output) return nullptr;
+
+        *out_len = static_cast<int>(output->size());
+        return output->c_str();
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    int release_job(int id) {
+        return runtime::release_job(id);
+    }
+
     // Write file to emscripten virtual filesystem
     EMSCRIPTEN_KEEPALIVE
     int write_file(const char* path, const char* content) {
-        try {
-            std::ofstream file(path, std::ios::binary);
-            if (!file.is_open()) {
-                emscripten_console_error("Failed to open file for writing");
-                return -1;
-            }
-            
-            file.write(content, strlen(content));
-            file.close();
-            
-            emscripten_console_log("File written successfully");
-            return 0;
-        } catch (const std::exception& e) {
-            emscripten_console_error(e.what());
+        static runtime::Metric& metric = export_metric("write_file");
+        runtime::MetricScope scope(metric);
+        if (!content) return -1;
+        const size_t len = strlen(content);
+        scope.add_bytes_in(len);
+        if (fs::write_bytes(path, reinterpret_cast<const uint8_t*>(content), len) != 0) {
+            emscripten_console_error("Failed to open file for writing");
             return -1;
         }
+
+        emscripten_console_log("File written successfully");
+        return 0;
+    }
+
+    // Write a byte span (e.g. from HEAPU8) to a file; binary-safe, no length scan
+    EMSCRIPTEN_KEEPALIVE
+    int write_file_bytes(const char* path, const uint8_t* data, int len) {
+        if (len < 0) return -1;
+        static runtime::Metric& metric = export_metric("write_file_bytes");
+        runtime::MetricScope scope(metric, static_cast<size_t>(len));
+        return fs::write_bytes(path, data, static_cast<size_t>(len));
+    }
+
+    // Append a byte span to a file, creating it if needed
+    EMSCRIPTEN_KEEPALIVE
+    int append_file_bytes(const char* path, const uint8_t* data, int len) {
+        if (len < 0) return -1;
+        static runtime::Metric& metric = export_metric("append_file_bytes");
+        runtime::MetricScope scope(metric, static_cast<size_t>(len));
+        return fs::write_bytes(path, data, static_cast<size_t>(len), true);
+    }
+
+    // Read len bytes at offset into a buffer that will be freed by JavaScript
+    static char* read_range_to_buffer(const char* path, int64_t offset, int64_t len, int* out_len) {
+        int64_t size = fs::file_size(path);
+        if (size < 0) {
+            emscripten_console_error("Failed to open file for reading");
+            return nullptr;
+        }
+
+        if (offset > size) offset = size;
+        if (len < 0 || len > size - offset) len = size - offset;
+
+        char* buffer = (char*)malloc(static_cast<size_t>(len) + 1);
+        if (!buffer) {
+            emscripten_console_error("Failed to allocate memory");
+            return nullptr;
+        }
+
+        int64_t read = fs::read_range(path, offset, reinterpret_cast<uint8_t*>(buffer), static_cast<size_t>(len));
+        if (read < 0) {
+            free(buffer);
+            emscripten_console_error("Failed to read file");
+            return nullptr;
+        }
+
+        buffer[read] = '\0';
+        *out_len = static_cast<int>(read);
+        return buffer;
     }
 
     // Read file from emscripten virtual filesystem
@@ -105,49 +373,243 @@ extern "C" {
     char* read_file(const char* path, int* out_len) {
         if (!out_len) return nullptr;
         *out_len = 0;
-        try {
-            std::ifstream file(path, std::ios::binary | std::ios::ate);
-            if (!file.is_open()) {
-                emscripten_console_error("Failed to open file for reading");
-                return nullptr;
-            }
 
-            auto size = file.tellg();
-            file.seekg(0, std::ios::beg);
+        static runtime::Metric& metric = export_metric("read_file");
+        runtime::MetricScope scope(metric);
+        char* buffer = read_range_to_buffer(path, 0, -1, out_len);
+        scope.add_bytes_out(static_cast<size_t>(*out_len));
+        return buffer;
+    }
 
-            // Allocate memory that will be freed by JavaScript
-            char* buffer = (char*)malloc(static_cast<size_t>(size) + 1);
-            if (!buffer) {
-                emscripten_console_error("Failed to allocate memory");
-                return nullptr;
-            }
+    // Read a whole file into the shared result region (status 0, or -1 with no data on failure)
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* read_file_result(const char* path) {
+        static runtime::Metric& metric = export_metric("read_file_result");
+        runtime::MetricScope scope(metric);
+        auto& buffer = runtime::result_buffer();
+        int64_t size = fs::file_size(path);
+        char* data = buffer.prepare(size > 0 ? static_cast<size_t>(size) : 0);
+        if (!data) return nullptr;
+        if (size < 0) return buffer.finish(-1, 0);
 
-            if (!file.read(buffer, size)) {
-                free(buffer);
-                emscripten_console_error("Failed to read file");
-                return nullptr;
-            }
+        int64_t read = fs::read_into(path, reinterpret_cast<uint8_t*>(data), static_cast<size_t>(size));
+        if (read > 0) scope.add_bytes_out(static_cast<size_t>(read));
+        return read < 0 ? buffer.finish(-1, 0) : buffer.finish(0, static_cast<size_t>(read));
+    }
 
-            buffer[size] = '\0';
-            *out_len = static_cast<int>(size);
-            return buffer;
-        } catch (const std::exception& e) {
-            emscripten_console_error(e.what());
-            return nullptr;
-        }
+    // Read at most len bytes starting at offset; the range is clamped to the file size
+    EMSCRIPTEN_KEEPALIVE
+    char* read_file_range(const char* path, int offset, int len, int* out_len) {
+        if (!out_len) return nullptr;
+        *out_len = 0;
+        if (offset < 0 || len < 0) return nullptr;
+
+        static runtime::Metric& metric = export_metric("read_file_range");
+        runtime::MetricScope scope(metric);
+        char* buffer = read_range_to_buffer(path, offset, len, out_len);
+        scope.add_bytes_out(static_cast<size_t>(*out_len));
+        return buffer;
+    }
+
+    // Size of a file in bytes (-1 if missing), so callers can size a buffer for read_file_into
+    EMSCRIPTEN_KEEPALIVE
+    int file_size(const char* path) {
+        return static_cast<int>(fs::file_size(path));
+    }
+
+    // Read a file into a caller-owned buffer (e.g. a region of HEAPU8) with a single copy.
+    // Returns the number of bytes read, at most cap, or -1 on failure.
+    EMSCRIPTEN_KEEPALIVE
+    int read_file_into(const char* path, uint8_t* buffer, int cap) {
+        if (cap < 0) return -1;
+
+        static runtime::Metric& metric = export_metric("read_file_into");
+        runtime::MetricScope scope(metric);
+        int n = static_cast<int>(fs::read_into(path, buffer, static_cast<size_t>(cap)));
+        if (n > 0) scope.add_bytes_out(static_cast<size_t>(n));
+        return n;
     }
 
-    // Check if file exists
+    // Open a file for chunked reading; returns a handle id (> 0) or -1
+    EMSCRIPTEN_KEEPALIVE
+    int open_reader(const char* path) {
+        return fs::open_handle(path);
+    }
+
+    // Read the next chunk into a caller-owned buffer; returns bytes read, 0 at EOF, -1 on error
+    EMSCRIPTEN_KEEPALIVE
+    int read_chunk(int handle, uint8_t* buffer, int cap) {
+        if (cap < 0) return -1;
+
+        static runtime::Metric& metric = export_metric("read_chunk");
+        runtime::MetricScope scope(metric);
+        int n = static_cast<int>(fs::read_handle(handle, buffer, static_cast<size_t>(cap)));
+        if (n > 0) scope.add_bytes_out(static_cast<size_t>(n));
+        return n;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    int close_reader(int handle) {
+        return fs::close_handle(handle);
+    }
+
+    // Open a persistent file handle; flags are fs::OpenFlags. Returns a handle id (> 0) or -1
+    EMSCRIPTEN_KEEPALIVE
+    int handle_open(const char* path, int flags) {
+        return fs::open_handle(path, flags);
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    int handle_read(int handle, uint8_t* buffer, int cap) {
+        if (cap < 0) return -1;
+
+        static runtime::Metric& metric = export_metric("handle_read");
+        runtime::MetricScope scope(metric);
+        int n = static_cast<int>(fs::read_handle(handle, buffer, static_cast<size_t>(cap)));
+        if (n > 0) scope.add_bytes_out(static_cast<size_t>(n));
+        return n;
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    int handle_write(int handle, const uint8_t* data, int len) {
+        if (len < 0) return -1;
+        static runtime::Metric& metric = export_metric("handle_write");
+        runtime::MetricScope scope(metric, static_cast<size_t>(len));
+        return static_cast<int>(fs::write_handle(handle, data, static_cast<size_t>(len)));
+    }
+
+    // whence: 0 = SET, 1 = CUR, 2 = END; returns the new offset or -1
+    EMSCRIPTEN_KEEPALIVE
+    int handle_seek(int handle, int offset, int whence) {
+        return static_cast<int>(fs::seek_handle(handle, offset, whence));
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    int handle_close(int handle) {
+        return fs::close_handle(handle);
+    }
+
+    // Back a path with Module.lazyRead; contents are fetched page by page on first read
+    EMSCRIPTEN_KEEPALIVE
+    int lazy_mount(const char* path, int size) {
+        return fs::lazy_mount(path, size);
+    }
+
+    // Drop the lazy backing for a path, leaving the (empty) placeholder in place
+    EMSCRIPTEN_KEEPALIVE
+    int lazy_unmount(const char* path) {
+        return fs::lazy_unmount(path);
+    }
+
+    // Set the byte budget for cached lazy pages
+    EMSCRIPTEN_KEEPALIVE
+    int lazy_set_budget(int bytes) {
+        if (bytes < 0) return -1;
+        fs::set_lazy_budget(static_cast<size_t>(bytes));
+        return 0;
+    }
+
+    // Fill out[5] with block cache counters: hits, misses, evictions, resident bytes, budget
+    EMSCRIPTEN_KEEPALIVE
+    int block_cache_stats(double* out) {
+        if (!out) return -1;
+        fs::CacheStats stats = fs::block_cache_stats();
+        out[0] = static_cast<double>(stats.hits);
+        out[1] = static_cast<double>(stats.misses);
+        out[2] = static_cast<double>(stats.evictions);
+        out[3] = static_cast<double>(stats.resident_bytes);
+        out[4] = static_cast<double>(stats.budget);
+        return 0;
+    }
+
+    // Set the byte budget for the block cache
+    EMSCRIPTEN_KEEPALIVE
+    int block_cache_set_budget(int bytes) {
+        if (bytes < 0) return -1;
+        fs::set_block_cache_budget(static_cast<size_t>(bytes));
+        return 0;
+    }
+
+    // Drop cached blocks for a path written outside the BIOS (null clears the cache)
+    EMSCRIPTEN_KEEPALIVE
+    int block_cache_invalidate(const char* path) {
+        fs::invalidate_cached(path);
+        return 0;
+    }
+
+    // Dedup writes of at least bytes through the blob store (0 turns it off)
+    EMSCRIPTEN_KEEPALIVE
+    int dedup_set_threshold(int bytes) {
+        if (bytes < 0) return -1;
+        fs::set_dedup_threshold(static_cast<size_t>(bytes));
+        return 0;
+    }
+
+    // Fill out[5] with dedup counters: blobs, references, stored bytes, logical bytes, hits
+    EMSCRIPTEN_KEEPALIVE
+    int dedup_stats(double* out) {
+        if (!out) return -1;
+        fs::DedupStats stats = fs::dedup_stats();
+        out[0] = static_cast<double>(stats.blobs);
+        out[1] = static_cast<double>(stats.references);
+        out[2] = static_cast<double>(stats.stored_bytes);
+        out[3] = static_cast<double>(stats.logical_bytes);
+        out[4] = static_cast<double>(stats.hits);
+        return 0;
+    }
+
+    // Check if file exists (answered from the dentry cache when possible)
     EMSCRIPTEN_KEEPALIVE
     int file_exists(const char* path) {
-        struct stat st;
-        return stat(path, &st) == 0 ? 1 : 0;
+        return fs::lookup_path(path) == 1 ? 1 : 0;
+    }
+
+    // Check many paths in one call. paths holds len bytes of NUL-separated paths (the last
+    // NUL is optional); the result region's status is the path count and its data is a
+    // bitmap where bit i (LSB first in each byte) is set if path i exists.
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* exists_many(const char* paths, int len) {
+        static runtime::Metric& metric = export_metric("exists_many");
+        runtime::MetricScope scope(metric, len > 0 ? static_cast<size_t>(len) : 0);
+        auto& buffer = runtime::result_buffer();
+        if (!paths || len < 0) {
+            if (!buffer.prepare(0)) return nullptr;
+            return buffer.finish(-1, 0);
+        }
+
+        const char* end = paths + len;
+        size_t count = 0;
+        for (const char* p = paths; p < end; ++count) {
+            const char* nul = static_cast<const char*>(memchr(p, '\0', static_cast<size_t>(end - p)));
+            p = nul ? nul + 1 : end;
+        }
+
+        const size_t bitmap_size = (count + 7) / 8;
+        char* bitmap = buffer.prepare(bitmap_size);
+        if (!bitmap) return nullptr;
+        memset(bitmap, 0, bitmap_size);
+
+        std::string last;
+        size_t index = 0;
+        for (const char* p = paths; p < end; ++index) {
+            const char* nul = static_cast<const char*>(memchr(p, '\0', static_cast<size_t>(end - p)));
+            const char* path = p;
+            if (!nul) {
+                last.assign(p, end);
+                path = last.c_str();
+            }
+            if (fs::lookup_path(path) == 1) bitmap[index / 8] |= static_cast<char>(1 << (index % 8));
+            p = nul ? nul + 1 : end;
+        }
+
+        scope.add_bytes_out(bitmap_size);
+        return buffer.finish(static_cast<int>(count), bitmap_size);
     }
 
     // Delete file
     EMSCRIPTEN_KEEPALIVE
     int delete_file(const char* path) {
-        if (remove(path) == 0) {
+        if (fs::remove_file(path) == 0) {
             emscripten_console_log("File deleted successfully");
             return 0;
         } else {
@@ -161,31 +623,510 @@ extern "C" {
     char* list_directory(const char* path, int* out_len) {
         if (!out_len) return nullptr;
         *out_len = 0;
-        DIR* dir = opendir(path);
-        if (!dir) {
-            emscripten_console_error("Failed to open directory");
-            return nullptr;
-        }
+
+        static runtime::Metric& metric = export_metric("list_directory");
+        runtime::MetricScope scope(metric);
 
         std::string result;
-        struct dirent* entry;
-        
-        while ((entry = readdir(dir)) != nullptr) {
-            result += entry->d_name;
-            result += "\n";
+        if (fs::list_directory(path, result, false) != 0) {
+            emscripten_console_error("Failed to open directory");
+            return nullptr;
         }
 
-        closedir(dir);
-
         // Allocate and copy result string
         char* buffer = (char*)malloc(result.size() + 1);
         if (!buffer) {
             emscripten_console_error("Failed to allocate memory for directory listing");
             return nullptr;
         }
-        
-        strcpy(buffer, result.c_str());
+
+        memcpy(buffer, result.c_str(), result.size() + 1);
         *out_len = static_cast<int>(result.size());
+        scope.add_bytes_out(result.size());
         return buffer;
     }
-} 
\ No newline at end of file
+
+    // Newline-separated listing in the shared result region (status 0, or -1 on failure)
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* list_directory_result(const char* path) {
+        static runtime::Metric& metric = export_metric("list_directory_result");
+        runtime::MetricScope scope(metric);
+        runtime::ScratchScope scratch;
+        commands::ScratchString listing;
+        if (fs::list_directory(path, listing, false) != 0) {
+            return runtime::result_buffer().set(-1, {});
+        }
+        scope.add_bytes_out(listing.size());
+        return runtime::result_buffer().set(0, listing);
+    }
+
+    // Fixed-size record for list_directory_ex; names live in a string table after the records
+    struct DirectoryRecord {
+        uint32_t name_offset;   // offset into the name table
+        uint32_t name_length;
+        uint8_t type;           // fs::EntryType
+        uint8_t reserved[3];
+        uint32_t mode;
+        double size;
+        double mtime;           // milliseconds since the epoch
+    };
+
+    static_assert(sizeof(DirectoryRecord) == 32, "DirectoryRecord layout is shared with JS");
+
+    struct DirectoryListing {
+        const char* glob;
+        std::vector<DirectoryRecord> records;
+        std::string names;
+    };
+
+    static fs::WalkAction collect_record(const fs::WalkEntry& entry, void* context) {
+        auto& listing = *static_cast<DirectoryListing*>(context);
+        if (listing.glob && fnmatch(listing.glob, entry.name.data(), 0) != 0) {
+            return fs::WalkAction::Continue;
+        }
+
+        DirectoryRecord record {};
+        record.name_offset = static_cast<uint32_t>(listing.names.size());
+        record.name_length = static_cast<uint32_t>(entry.relative.size());
+        record.type = static_cast<uint8_t>(entry.type);
+
+        struct stat st;
+        if (stat(entry.path.data(), &st) == 0 || lstat(entry.path.data(), &st) == 0) {
+            record.mode = static_cast<uint32_t>(st.st_mode);
+            record.size = static_cast<double>(st.st_size);
+            record.mtime = static_cast<double>(st.st_mtim.tv_sec) * 1000.0 + st.st_mtim.tv_nsec / 1e6;
+        }
+        if (entry.type == fs::EntryType::File && record.size == 0) {
+            int64_t lazy_size = fs::file_size(entry.path.data());  // lazy placeholders are empty
+            if (lazy_size > 0) record.size = static_cast<double>(lazy_size);
+        }
+
+        listing.records.push_back(record);
+        listing.names.append(entry.relative);
+        return fs::WalkAction::Continue;
+    }
+
+    // List a directory as packed binary records in one call:
+    // [uint32 count][uint32 record size][uint32 names offset][uint32 reserved]
+    // followed by count DirectoryRecords and then the name table (paths relative to path).
+    // depth is how many levels of subdirectories to enter (negative for unlimited);
+    // glob, if not empty, filters entries by name with fnmatch.
+    EMSCRIPTEN_KEEPALIVE
+    char* list_directory_ex(const char* path, int depth, const char* glob, int* out_len) {
+        if (!out_len) return nullptr;
+        *out_len = 0;
+
+        static runtime::Metric& metric = export_metric("list_directory_ex");
+        runtime::MetricScope scope(metric);
+
+        DirectoryListing listing { glob && *glob ? glob : nullptr, {}, {} };
+        if (fs::walk(path, depth, collect_record, &listing) != 0) {
+            emscripten_console_error("Failed to open directory");
+            return nullptr;
+        }
+
+        const uint32_t header[4] = {
+            static_cast<uint32_t>(listing.records.size()),
+            static_cast<uint32_t>(sizeof(DirectoryRecord)),
+            static_cast<uint32_t>(sizeof(header) + listing.records.size() * sizeof(DirectoryRecord)),
+            0
+        };
+        const size_t total = header[2] + listing.names.size();
+
+        char* buffer = (char*)malloc(total);
+        if (!buffer) {
+            emscripten_console_error("Failed to allocate memory for directory listing");
+            return nullptr;
+        }
+
+        memcpy(buffer, header, sizeof(header));
+        if (!listing.records.empty()) {
+            memcpy(buffer + sizeof(header), listing.records.data(), listing.records.size() * sizeof(DirectoryRecord));
+        }
+        memcpy(buffer + header[2], listing.names.data(), listing.names.size());
+        *out_len = static_cast<int>(total);
+        scope.add_bytes_out(total);
+        return buffer;
+    }
+
+    // Changes journaled after since_seq (0 for everything retained), packed as a 16-byte
+    // header [uint32 count][uint32 last seq][uint32 complete][uint32 reserved] then per
+    // event [uint32 seq][uint32 op][uint32 path length][path bytes, padded to 4].
+    // complete is 0 when a rescan is needed: events after since_seq were overwritten, or
+    // since_seq is ahead of the journal because it was saved before the module reloaded.
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* read_changes(int since_seq) {
+        static runtime::Metric& metric = export_metric("read_changes");
+        runtime::MetricScope scope(metric);
+
+        std::vector<fs::ChangeEvent> events;
+        uint32_t last_seq = 0;
+        const bool complete = fs::read_changes(static_cast<uint32_t>(since_seq), events, last_seq);
+
+        size_t total = 4 * sizeof(uint32_t);
+        for (const fs::ChangeEvent& event : events) total += 3 * sizeof(uint32_t) + ((event.path.size() + 3) & ~static_cast<size_t>(3));
+
+        auto& buffer = runtime::result_buffer();
+        char* data = buffer.prepare(total);
+        if (!data) return nullptr;
+
+        const uint32_t header[4] = { static_cast<uint32_t>(events.size()), last_seq, complete ? 1u : 0u, 0 };
+        memcpy(data, header, sizeof(header));
+        size_t offset = sizeof(header);
+        for (const fs::ChangeEvent& event : events) {
+            const uint32_t record[3] = { event.seq, static_cast<uint32_t>(event.op), static_cast<uint32_t>(event.path.size()) };
+            memcpy(data + offset, record, sizeof(record));
+            offset += sizeof(record);
+            const size_t padded = (event.path.size() + 3) & ~static_cast<size_t>(3);
+            memcpy(data + offset, event.path.data(), event.path.size());
+            memset(data + offset + event.path.size(), 0, padded - event.path.size());
+            offset += padded;
+        }
+
+        scope.add_bytes_out(total);
+        return buffer.finish(0, total);
+    }
+
+    static uint8_t* prepare_image(size_t size, void* context) {
+        return reinterpret_cast<uint8_t*>(static_cast<runtime::ResultBuffer*>(context)->prepare(size));
+    }
+
+    // Pack the tree under root into one image in the shared result region (layout in
+    // fs/image.cpp); copy it out, e.g. to IndexedDB, and hand it back to fs_restore
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* fs_snapshot(const char* root) {
+        static runtime::Metric& metric = export_metric("fs_snapshot");
+        runtime::MetricScope scope(metric);
+        auto& buffer = runtime::result_buffer();
+
+        int64_t size = fs::snapshot_tree(root, prepare_image, &buffer);
+        if (size < 0) {
+            if (!buffer.prepare(0)) return nullptr;
+            return buffer.finish(-1, 0);
+        }
+        scope.add_bytes_out(static_cast<size_t>(size));
+        return buffer.finish(0, static_cast<size_t>(size));
+    }
+
+    // Unpack an fs_snapshot image under root in one call; returns the entry count or -1
+    EMSCRIPTEN_KEEPALIVE
+    int fs_restore(const uint8_t* image, int len, const char* root) {
+        static runtime::Metric& metric = export_metric("fs_restore");
+        runtime::MetricScope scope(metric, len > 0 ? static_cast<size_t>(len) : 0);
+        if (len < 0) return -1;
+
+        int64_t restored = fs::restore_tree(image, static_cast<size_t>(len), root);
+        return restored < 0 ? -1 : static_cast<int>(restored);
+    }
+
+    // Codec output collected into the shared result region
+    struct ResultAppender {
+        runtime::ResultBuffer& buffer;
+        size_t length;
+        bool failed;
+    };
+
+    static void append_result(const uint8_t* data, size_t len, void* context) {
+        auto& result = *static_cast<ResultAppender*>(context);
+        if (result.failed) return;
+
+        char* dest = result.buffer.grow(result.length + len);
+        if (!dest) {
+            result.failed = true;
+            return;
+        }
+        memcpy(dest + result.length, data, len);
+        result.length += len;
+    }
+
+    static bool valid_codec(int codec) {
+        return codec == static_cast<int>(kernels::Codec::Gzip) || codec == static_cast<int>(kernels::Codec::Lz4);
+    }
+
+    static runtime::ResultHeader* run_codec_bytes(runtime::Metric& metric, kernels::CodecStream* stream,
+                                                  const uint8_t* data, int len, size_t reserve) {
+        runtime::MetricScope scope(metric, len > 0 ? static_cast<size_t>(len) : 0);
+        auto& buffer = runtime::result_buffer();
+        if (!buffer.prepare(reserve)) return nullptr;
+        if (!stream || len < 0 || (!data && len > 0)) return buffer.finish(-1, 0);
+
+        ResultAppender result { buffer, 0, false };
+        int status = stream->update(data, static_cast<size_t>(len), append_result, &result);
+        if (status == 0) status = stream->finish(append_result, &result);
+        scope.add_bytes_out(result.length);
+        return buffer.finish(status == 0 && !result.failed ? 0 : -1, result.length);
+    }
+
+    // Compress a byte span in one call; codec is kernels::Codec, level 0 picks the default
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* compress_bytes(int codec, const uint8_t* data, int len, int level) {
+        static runtime::Metric& metric = export_metric("compress_bytes");
+        auto stream = valid_codec(codec) ? kernels::make_compressor(static_cast<kernels::Codec>(codec), level) : nullptr;
+        return run_codec_bytes(metric, stream.get(), data, len, len > 0 ? static_cast<size_t>(len) / 2 : 0);
+    }
+
+    // Decompress a complete gzip/zlib or LZ4 frame byte span
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* decompress_bytes(int codec, const uint8_t* data, int len) {
+        static runtime::Metric& metric = export_metric("decompress_bytes");
+        auto stream = valid_codec(codec) ? kernels::make_decompressor(static_cast<kernels::Codec>(codec)) : nullptr;
+        return run_codec_bytes(metric, stream.get(), data, len, len > 0 ? static_cast<size_t>(len) * 4 : 0);
+    }
+
+    // Incremental codec streams for data arriving in pieces (e.g. a fetch body); ids start
+    // at 1. Only driven from JS on the main thread, so the table needs no lock.
+    static std::vector<std::unique_ptr<kernels::CodecStream>> codec_streams;
+
+    static kernels::CodecStream* lookup_codec(int id) {
+        if (id <= 0 || static_cast<size_t>(id) > codec_streams.size()) return nullptr;
+        return codec_streams[id - 1].get();
+    }
+
+    EMSCRIPTEN_KEEPALIVE
+    int codec_open(int codec, int decompress, int level) {
+        if (!valid_codec(codec)) return -1;
+
+        auto stream = decompress
+            ? kernels::make_decompressor(static_cast<kernels::Codec>(codec))
+            : kernels::make_compressor(static_cast<kernels::Codec>(codec), level);
+        for (size_t i = 0; i < codec_streams.size(); ++i) {
+            if (!codec_streams[i]) {
+                codec_streams[i] = std::move(stream);
+                return static_cast<int>(i + 1);
+            }
+        }
+        codec_streams.push_back(std::move(stream));
+        return static_cast<int>(codec_streams.size());
+    }
+
+    // Feed a chunk; the result region holds whatever output it produced (possibly none)
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* codec_update(int id, const uint8_t* data, int len) {
+        static runtime::Metric& metric = export_metric("codec_update");
+        runtime::MetricScope scope(metric, len > 0 ? static_cast<size_t>(len) : 0);
+        auto& buffer = runtime::result_buffer();
+        if (!buffer.prepare(0)) return nullptr;
+
+        kernels::CodecStream* stream = lookup_codec(id);
+        if (!stream || len < 0 || (!data && len > 0)) return buffer.finish(-1, 0);
+
+        ResultAppender result { buffer, 0, false };
+        int status = stream->update(data, static_cast<size_t>(len), append_result, &result);
+        scope.add_bytes_out(result.length);
+        return buffer.finish(status == 0 && !result.failed ? 0 : -1, result.length);
+    }
+
+    // Flush the remaining output and release the stream; status -1 means truncated input
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* codec_finish(int id) {
+        static runtime::Metric& metric = export_metric("codec_finish");
+        runtime::MetricScope scope(metric);
+        auto& buffer = runtime::result_buffer();
+        if (!buffer.prepare(0)) return nullptr;
+
+        kernels::CodecStream* stream = lookup_codec(id);
+        if (!stream) return buffer.finish(-1, 0);
+
+        ResultAppender result { buffer, 0, false };
+        int status = stream->finish(append_result, &result);
+        codec_streams[id - 1].reset();
+        scope.add_bytes_out(result.length);
+        return buffer.finish(status == 0 && !result.failed ? 0 : -1, result.length);
+    }
+
+    static void write_handle_output(const uint8_t* data, size_t len, void* context) {
+        int* handle = static_cast<int*>(context);
+        if (*handle > 0 && fs::write_handle(*handle, data, len) < 0) *handle = -1;
+    }
+
+    // Stream everything left in one file handle through a codec into another
+    EMSCRIPTEN_KEEPALIVE
+    int codec_pipe(int codec, int decompress, int level, int in_handle, int out_handle) {
+        if (!valid_codec(codec)) return -1;
+        static runtime::Metric& metric = export_metric("codec_pipe");
+        runtime::MetricScope scope(metric);
+
+        auto stream = decompress
+            ? kernels::make_decompressor(static_cast<kernels::Codec>(codec))
+            : kernels::make_compressor(static_cast<kernels::Codec>(codec), level);
+
+        std::vector<uint8_t> chunk(64 * 1024);
+        int target = out_handle;
+        int64_t n;
+        while ((n = fs::read_handle(in_handle, chunk.data(), chunk.size())) > 0) {
+            scope.add_bytes_in(static_cast<size_t>(n));
+            if (stream->update(chunk.data(), static_cast<size_t>(n), write_handle_output, &target) != 0) return -1;
+            if (target < 0) return -1;
+        }
+        if (n < 0 || stream->finish(write_handle_output, &target) != 0) return -1;
+        return target < 0 ? -1 : 0;
+    }
+
+    // bios_* kernels work in place on caller-owned HEAPU8 spans: nothing is copied or
+    // allocated. They skip metrics, since on per-frame and per-packet paths the clock
+    // reads would cost as much as the work. Batch variants take count [ptr, len] int32
+    // pairs and fill one int32 result per span.
+
+    static const uint8_t* span_data(const int32_t* spans, int index) {
+        return reinterpret_cast<const uint8_t*>(static_cast<uintptr_t>(static_cast<uint32_t>(spans[index * 2])));
+    }
+
+    static size_t span_length(const int32_t* spans, int index) {
+        return spans[index * 2 + 1] > 0 ? static_cast<size_t>(spans[index * 2 + 1]) : 0;
+    }
+
+    // Offset of the first byte equal to byte, or -1
+    EMSCRIPTEN_KEEPALIVE
+    int bios_memchr(const uint8_t* data, int len, int byte) {
+        if (!data || len <= 0) return -1;
+        const uint8_t* hit = kernels::find_byte(data, static_cast<size_t>(len), static_cast<uint8_t>(byte));
+        return hit ? static_cast<int>(hit - data) : -1;
+    }
+
+    // Offset of the first occurrence of needle, or -1
+    EMSCRIPTEN_KEEPALIVE
+    int bios_memmem(const uint8_t* data, int len, const uint8_t* needle, int needle_len) {
+        if (!data || len < 0 || (!needle && needle_len > 0) || needle_len < 0) return -1;
+        const uint8_t* hit = kernels::find_bytes(data, static_cast<size_t>(len), needle, static_cast<size_t>(needle_len));
+        return hit ? static_cast<int>(hit - data) : -1;
+    }
+
+    // Number of bytes equal to byte
+    EMSCRIPTEN_KEEPALIVE
+    int bios_count_byte(const uint8_t* data, int len, int byte) {
+        if (!data || len <= 0) return 0;
+        return static_cast<int>(kernels::count_byte(data, static_cast<size_t>(len), static_cast<uint8_t>(byte)));
+    }
+
+    // Base64-encode into out (url: -_ alphabet, no padding); returns chars written, or -1
+    // if capacity is short of base64_encoded_size(len, url): 4 * ceil(len / 3) padded,
+    // (4 * len + 2) / 3 when url is set
+    EMSCRIPTEN_KEEPALIVE
+    int bios_base64_encode(const uint8_t* data, int len, char* out, int capacity, int url) {
+        if ((!data && len > 0) || len < 0 || !out) return -1;
+        if (kernels::base64_encoded_size(static_cast<size_t>(len), url != 0) > static_cast<size_t>(capacity < 0 ? 0 : capacity)) return -1;
+        return static_cast<int>(kernels::base64_encode(data, static_cast<size_t>(len), out, url != 0));
+    }
+
+    // Decode either Base64 alphabet into out; returns bytes written, or -1 if the input is
+    // invalid or capacity is too small
+    EMSCRIPTEN_KEEPALIVE
+    int bios_base64_decode(const char* data, int len, uint8_t* out, int capacity) {
+        if ((!data && len > 0) || len < 0 || !out) return -1;
+        if (kernels::base64_decoded_size(data, static_cast<size_t>(len)) > static_cast<size_t>(capacity < 0 ? 0 : capacity)) return -1;
+        return static_cast<int>(kernels::base64_decode(data, static_cast<size_t>(len), out));
+    }
+
+    // Lower-case hex into out (2 * len chars); returns chars written or -1
+    EMSCRIPTEN_KEEPALIVE
+    int bios_hex_encode(const uint8_t* data, int len, char* out, int capacity) {
+        if ((!data && len > 0) || len < 0 || !out || capacity / 2 < len) return -1;
+        kernels::hex_encode(data, static_cast<size_t>(len), out);
+        return len * 2;
+    }
+
+    // Decode hex of either case into out (len / 2 bytes); returns bytes written or -1
+    EMSCRIPTEN_KEEPALIVE
+    int bios_hex_decode(const char* data, int len, uint8_t* out, int capacity) {
+        if ((!data && len > 0) || len < 0 || !out || capacity < len / 2) return -1;
+        return static_cast<int>(kernels::hex_decode(data, static_cast<size_t>(len), out));
+    }
+
+    // len if the span is valid UTF-8, otherwise the offset of the first bad sequence
+    EMSCRIPTEN_KEEPALIVE
+    int bios_utf8_validate(const uint8_t* data, int len) {
+        if (!data || len <= 0) return 0;
+        return static_cast<int>(kernels::utf8_validate(data, static_cast<size_t>(len)));
+    }
+
+    // Swap the byte order of every width-byte unit (2, 4 or 8) in place
+    EMSCRIPTEN_KEEPALIVE
+    int bios_bswap(uint8_t* data, int len, int width) {
+        if ((!data && len > 0) || len < 0 || (width != 2 && width != 4 && width != 8)) return -1;
+        kernels::byte_swap(data, static_cast<size_t>(len), static_cast<size_t>(width));
+        return 0;
+    }
+
+    // bios_memchr over each span; results[i] is an offset or -1
+    EMSCRIPTEN_KEEPALIVE
+    int bios_memchr_batch(const int32_t* spans, int count, int byte, int32_t* results) {
+        if (!spans || !results || count < 0) return -1;
+        for (int i = 0; i < count; ++i) {
+            const uint8_t* data = span_data(spans, i);
+            const uint8_t* hit = data ? kernels::find_byte(data, span_length(spans, i), static_cast<uint8_t>(byte)) : nullptr;
+            results[i] = hit ? static_cast<int32_t>(hit - data) : -1;
+        }
+        return count;
+    }
+
+    // bios_memmem of one needle over each span
+    EMSCRIPTEN_KEEPALIVE
+    int bios_memmem_batch(const int32_t* spans, int count, const uint8_t* needle, int needle_len, int32_t* results) {
+        if (!spans || !results || count < 0 || needle_len < 0 || (!needle && needle_len > 0)) return -1;
+        for (int i = 0; i < count; ++i) {
+            const uint8_t* data = span_data(spans, i);
+            const uint8_t* hit = data ? kernels::find_bytes(data, span_length(spans, i), needle, static_cast<size_t>(needle_len)) : nullptr;
+            results[i] = hit ? static_cast<int32_t>(hit - data) : -1;
+        }
+        return count;
+    }
+
+    // bios_utf8_validate over each span
+    EMSCRIPTEN_KEEPALIVE
+    int bios_utf8_validate_batch(const int32_t* spans, int count, int32_t* results) {
+        if (!spans || !results || count < 0) return -1;
+        for (int i = 0; i < count; ++i) {
+            const uint8_t* data = span_data(spans, i);
+            results[i] = data ? static_cast<int32_t>(kernels::utf8_validate(data, span_length(spans, i))) : 0;
+        }
+        return count;
+    }
+
+    // bios_bswap over each span with one width
+    EMSCRIPTEN_KEEPALIVE
+    int bios_bswap_batch(const int32_t* spans, int count, int width) {
+        if (!spans || count < 0 || (width != 2 && width != 4 && width != 8)) return -1;
+        for (int i = 0; i < count; ++i) {
+            uint8_t* data = const_cast<uint8_t*>(span_data(spans, i));
+            if (data) kernels::byte_swap(data, span_length(spans, i), static_cast<size_t>(width));
+        }
+        return count;
+    }
+
+    // Metrics snapshot as JSON in the shared result region:
+    // {"exports":{name:metric},"commands":{name:metric},"blockCache":{...},"dentryCache":{...},"dedup":{...}}
+    // where a metric is
+    // {calls, bytesIn, bytesOut, totalMs, maxMs, latencyLog2Us[24]} (see runtime/metrics.hpp)
+    EMSCRIPTEN_KEEPALIVE
+    runtime::ResultHeader* get_metrics() {
+        std::string json = "{";
+        runtime::append_metrics_json(json);
+
+        const fs::CacheStats cache = fs::block_cache_stats();
+        json += ",\"blockCache\":{\"hits\":" + std::to_string(cache.hits) +
+            ",\"misses\":" + std::to_string(cache.misses) +
+            ",\"evictions\":" + std::to_string(cache.evictions) +
+            ",\"residentBytes\":" + std::to_string(cache.resident_bytes) +
+            ",\"budget\":" + std::to_string(cache.budget) + "}";
+
+        const fs::DentryStats dentries = fs::dentry_cache_stats();
+        json += ",\"dentryCache\":{\"hits\":" + std::to_string(dentries.hits) +
+            ",\"misses\":" + std::to_string(dentries.misses) +
+            ",\"entries\":" + std::to_string(dentries.entries) + "}";
+
+        const fs::DedupStats dedup = fs::dedup_stats();
+        json += ",\"dedup\":{\"blobs\":" + std::to_string(dedup.blobs) +
+            ",\"references\":" + std::to_string(dedup.references) +
+            ",\"storedBytes\":" + std::to_string(dedup.stored_bytes) +
+            ",\"logicalBytes\":" + std::to_string(dedup.logical_bytes) +
+            ",\"hits\":" + std::to_string(dedup.hits) + "}}";
+        return runtime::result_buffer().set(0, json);
+    }
+
+    // Zero all counters
+    EMSCRIPTEN_KEEPALIVE
+    int reset_metrics() {
+        runtime::reset_metrics();
+        return 0;
+    }
+}
@@ -7,20 +7,138 @@ declare module '@ecmaos/bios' {
     _free(ptr: number): void
     _init(): number
     _get_version(): string
+    // Every _execute* export takes a full command line: cmd | cmd, > / >> / < redirection,
+    // and ; && || lists, all run inside the module in one call
     _execute(command: string): number
     _execute_with_output(command: string, outLenPtr: number): number
+    // *_result exports return a pointer to the shared result region (see BIOSResultHeader);
+    // it is reused by the next *_result call and must not be freed
+    _execute_result(command: string): number
+    // Packed result: [int32 count] then per command [int32 code][int32 length][bytes, padded to 4]
+    _execute_batch(commandsPtr: number, length: number, outLenPtr: number): number
+    // Streams output to onOutput; returns the exit code
+    _execute_streaming(command: string): number
     _get_last_status(): number
 
+    // Jobs run on the worker pool in the threads build, inline otherwise
+    _execute_async(command: string): number
+    // Int32 view at ptr >> 2: [capacity, head, tail, dropped] then capacity [jobId, code] pairs;
+    // read entries from tail up to head, then store the new tail
+    _completion_ring(): number
+    _poll_job(id: number): BIOSJobState
+    _wait_job(id: number): number
+    _job_output(id: number, outLenPtr: number): number
+    _release_job(id: number): number
+
     // File system operations
     FS: typeof FS
     _write_file(path: string, content: string): number
+    _write_file_bytes(path: string, dataPtr: number, length: number): number
+    _append_file_bytes(path: string, dataPtr: number, length: number): number
     _read_file(path: string, outLenPtr: number): number
+    _read_file_result(path: string): number
+    _file_size(path: string): number
+    _read_file_into(path: string, bufferPtr: number, capacity: number): number
+    _read_file_range(path: string, offset: number, length: number, outLenPtr: number): number
+    _open_reader(path: string): number
+    _read_chunk(handle: number, bufferPtr: number, capacity: number): number
+    _close_reader(handle: number): number
+    _handle_open(path: string, flags: number): number
+    _handle_read(handle: number, bufferPtr: number, capacity: number): number
+    _handle_write(handle: number, dataPtr: number, length: number): number
+    _handle_seek(handle: number, offset: number, whence: number): number
+    _handle_close(handle: number): number
+    // Lazy mounts: bytes come from lazyRead on first read and are cached in 64KB pages
+    _lazy_mount(path: string, size: number): number
+    _lazy_unmount(path: string): number
+    _lazy_set_budget(bytes: number): number
+    // Block cache for file reads; statsPtr receives 5 doubles indexed by BIOSCacheStat
+    _block_cache_stats(statsPtr: number): number
+    _block_cache_set_budget(bytes: number): number
+    // Call after writing a file through FS directly; pass 0 to clear the whole cache
+    _block_cache_invalidate(path: string | 0): number
+    // Dedup: writes of at least bytes share one blob per distinct content (0, the default,
+    // turns it off). Deduped files are empty placeholders to FS, so read them via the BIOS.
+    _dedup_set_threshold(bytes: number): number
+    // statsPtr receives 5 doubles indexed by BIOSDedupStat
+    _dedup_stats(statsPtr: number): number
     _file_exists(path: string): number
+    // pathsPtr holds NUL-separated UTF-8 paths; returns the result region, whose STATUS is
+    // the path count and whose data is a bitmap (bit i, LSB first, set if path i exists)
+    _exists_many(pathsPtr: number, length: number): number
     _delete_file(path: string): number
     _list_directory(path: string, outLenPtr: number): number
+    _list_directory_result(path: string): number
+    // Packed listing: 16-byte header [count, recordSize, namesOffset, 0] (uint32),
+    // then count 32-byte records, then the UTF-8 name table. Each record is
+    // [uint32 nameOffset][uint32 nameLength][uint8 type (BIOSEntryType)][3 pad][uint32 mode]
+    // [float64 size][float64 mtimeMs]. depth < 0 recurses without limit; glob '' matches all.
+    _list_directory_ex(path: string, depth: number, glob: string, outLenPtr: number): number
+    // Packed tree image (uint32 little-endian throughout): 32-byte header [magic 'BFS1',
+    // version, count, entrySize, namesOffset, dataOffset, imageSize, 0], then count 24-byte
+    // entries sorted by path [nameOffset][nameLength][uint8 type (BIOSEntryType), 3 pad]
+    // [mode][dataOffset][size], then NUL-terminated relative paths, then 8-byte aligned data.
+    // _fs_snapshot returns the result region; _fs_restore returns the entry count or -1.
+    _fs_snapshot(root: string): number
+    _fs_restore(imagePtr: number, length: number, root: string): number
+    // Change journal from the result region: [count, lastSeq, complete, 0] (uint32) then per
+    // event [seq][op (BIOSChangeOp)][pathLength][path bytes, padded to 4]. Pass the last
+    // lastSeq back in; complete 0 means a rescan is needed (events were overwritten, or
+    // sinceSeq predates a module reload). Meant for one reader at a time.
+    _read_changes(sinceSeq: number): number
+
+    // Compression (codec is BIOSCodec); byte-span calls return the shared result region
+    _compress_bytes(codec: number, dataPtr: number, len: number, level: number): number
+    _decompress_bytes(codec: number, dataPtr: number, len: number): number
+    // Incremental streams: each update/finish returns the output produced so far
+    _codec_open(codec: number, decompress: number, level: number): number
+    _codec_update(stream: number, dataPtr: number, len: number): number
+    _codec_finish(stream: number): number
+    // Pump the rest of inHandle through a codec into outHandle (handles from _handle_open)
+    _codec_pipe(codec: number, decompress: number, level: number, inHandle: number, outHandle: number): number
+
+    // Kernels on caller-owned HEAPU8 spans, in place with no copies or allocation.
+    // Searches return an offset or -1; encoders/decoders return bytes written or -1 when
+    // the input is invalid or capacity is short
+    _bios_memchr(dataPtr: number, len: number, byte: number): number
+    _bios_memmem(dataPtr: number, len: number, needlePtr: number, needleLen: number): number
+    _bios_count_byte(dataPtr: number, len: number, byte: number): number
+    // Encoded size is 4 * ceil(len / 3), or floor((4 * len + 2) / 3) unpadded when url is 1
+    _bios_base64_encode(dataPtr: number, len: number, outPtr: number, capacity: number, url: number): number
+    // Accepts either alphabet, padded or not
+    _bios_base64_decode(dataPtr: number, len: number, outPtr: number, capacity: number): number
+    _bios_hex_encode(dataPtr: number, len: number, outPtr: number, capacity: number): number
+    _bios_hex_decode(dataPtr: number, len: number, outPtr: number, capacity: number): number
+    // Returns len if valid, otherwise the offset of the first invalid sequence
+    _bios_utf8_validate(dataPtr: number, len: number): number
+    // Reverses every width-byte unit (2, 4 or 8) in place; a trailing partial unit is left alone
+    _bios_bswap(dataPtr: number, len: number, width: number): number
+    // Batches: spansPtr holds count [ptr, len] int32 pairs and resultsPtr receives one int32
+    // per span; each returns count, or -1 on bad arguments
+    _bios_memchr_batch(spansPtr: number, count: number, byte: number, resultsPtr: number): number
+    _bios_memmem_batch(spansPtr: number, count: number, needlePtr: number, needleLen: number, resultsPtr: number): number
+    _bios_utf8_validate_batch(spansPtr: number, count: number, resultsPtr: number): number
+    _bios_bswap_batch(spansPtr: number, count: number, width: number): number
+
+    // Metrics snapshot: result region holding JSON (BIOSMetrics in @ecmaos/types)
+    _get_metrics(): number
+    _reset_metrics(): number
 
     HEAPU8: Uint8Array
     HEAP32: Int32Array
+
+    // Receives streamed command output; the chunk is a view into HEAPU8, copy it to keep it
+    onOutput?: (chunk: Uint8Array) => void
+    // Called on the main thread when a job from _execute_async finishes
+    onJobComplete?: (id: number, code: number) => void
+    // Page source for _lazy_mount; must return synchronously, null on failure
+    lazyRead?: (path: string, offset: number, length: number) => Uint8Array | null
+  }
+
+  export interface BIOSOptions extends Partial<EmscriptenModule> {
+    onOutput?: (chunk: Uint8Array) => void
+    onJobComplete?: (id: number, code: number) => void
+    lazyRead?: (path: string, offset: number, length: number) => Uint8Array | null
   }
 
   export enum BIOSState {
@@ -29,15 +147,100 @@ declare module '@ecmaos/bios' {
     PANIC = 2
   }
 
+  // Int32 offsets of the result region header; data starts HEADER_SIZE bytes after the pointer
+  export enum BIOSResultHeader {
+    LENGTH = 0,
+    STATUS = 1,
+    CAPACITY = 2,
+    HEADER_SIZE = 16
+  }
+
+  export enum BIOSJobState {
+    UNKNOWN = -1,
+    PENDING = 0,
+    RUNNING = 1,
+    DONE = 2
+  }
+
+  // Codecs for the compression exports
+  export enum BIOSCodec {
+    GZIP = 0,
+    LZ4 = 1
+  }
+
+  // Entry types reported by _list_directory_ex
+  export enum BIOSEntryType {
+    UNKNOWN = 0,
+    FILE = 1,
+    DIRECTORY = 2,
+    SYMLINK = 3,
+    OTHER = 4
+  }
+
+  // Flags for _handle_open, combined with bitwise OR
+  export enum BIOSOpenFlags {
+    READ = 1,
+    WRITE = 2,
+    CREATE = 4,
+    TRUNCATE = 8,
+    APPEND = 16
+  }
+
+  // Slots filled by _block_cache_stats
+  export enum BIOSCacheStat {
+    HITS = 0,
+    MISSES = 1,
+    EVICTIONS = 2,
+    RESIDENT_BYTES = 3,
+    BUDGET = 4
+  }
+
+  // Slots filled by _dedup_stats
+  export enum BIOSDedupStat {
+    BLOBS = 0,
+    REFERENCES = 1,
+    STORED_BYTES = 2,
+    LOGICAL_BYTES = 3,
+    HITS = 4
+  }
+
+  // Operations reported by _read_changes; a rename is REMOVE of the source, WRITE of the target
+  export enum BIOSChangeOp {
+    WRITE = 1,
+    REMOVE = 2
+  }
+
+  // Origins for _handle_seek
+  export enum BIOSSeek {
+    SET = 0,
+    CUR = 1,
+    END = 2
+  }
+
   // Factory function type that creates the module
   export interface CreateBIOS {
-    (options?: Partial<EmscriptenModule>): Promise<BIOSModule>
+    (options?: BIOSOptions): Promise<BIOSModule>
   }
 
   const createBIOS: CreateBIOS
   export default createBIOS
 }
 
+// Size-optimized build (-Oz, Closure) with the same interface; prefer it when cold start
+// matters more than throughput, e.g. import(fast ? '@ecmaos/bios' : '@ecmaos/bios/min')
+declare module '@ecmaos/bios/min' {
+  export * from '@ecmaos/bios'
+  import createBIOS from '@ecmaos/bios'
+  export default createBIOS
+}
+
+// pthreads build with a worker pool; requires SharedArrayBuffer (COOP/COEP headers)
+declare module '@ecmaos/bios/threads' {
+  export * from '@ecmaos/bios'
+  import createBIOS from '@ecmaos/bios'
+  export default createBIOS
+}
+
 // Augment the global scope to include the BIOS instance
 declare global {
   interface Window {
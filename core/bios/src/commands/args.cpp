@@ -0,0 +1,36 @@
+#include "commands.hpp"
+
+namespace commands {
+    size_t split_args(std::string_view args, std::string_view* argv, size_t max_args) {
+        size_t count = 0;
+        size_t i = 0;
+        while (i < args.size()) {
+            while (i < args.size() && (args[i] == ' ' || args[i] == '\t')) ++i;
+            if (i >= args.size()) break;
+
+            size_t start = i;
+            size_t end;
+            if (args[i] == '"' || args[i] == '\'') {
+                const char quote = args[i];
+                start = ++i;
+                while (i < args.size() && args[i] != quote) ++i;
+                end = i;
+                if (i < args.size()) ++i;
+            } else {
+                while (i < args.size() && args[i] != ' ' && args[i] != '\t') ++i;
+                end = i;
+            }
+
+            if (count < max_args) argv[count] = args.substr(start, end - start);
+            ++count;
+        }
+        return count;
+    }
+
+    std::string_view path_argument(std::string_view args) {
+        if (args.size() >= 2 && (args.front() == '"' || args.front() == '\'') && args.back() == args.front()) {
+            return args.substr(1, args.size() - 2);
+        }
+        return args;
+    }
+}
@@ -1,26 +1,28 @@
 #include "commands.hpp"
-#include <emscripten/console.h>
-#include <fstream>
+#include "io.hpp"
 
 namespace commands {
-    CommandResult cat(const std::string& args) {
-        if (args.empty()) {
-            return { -1, "Usage: cat <filename>" };
+    int cat(std::string_view args, OutputSink& out, const CommandInput& in) {
+        if (args.empty() && !in.piped) {
+            out.error("Usage: cat <filename>");
+            return -1;
         }
 
-        std::ifstream file(args, std::ios::binary | std::ios::ate);
-        if (!file.is_open()) {
-            return { -1, "Failed to open file" };
-        }
-
-        std::streamsize size = file.tellg();
-        file.seekg(0, std::ios::beg);
+        // Stream the file (or piped input) through the sink one chunk at a time
+        const ScratchString path(path_argument(args));
+        int status = read_source(path.c_str(), in, [&](const uint8_t* data, size_t len) {
+            out.write(std::string_view(reinterpret_cast<const char*>(data), len));
+        });
 
-        std::string content(size, '\0');
-        if (!file.read(&content[0], size)) {
-            return { -1, "Failed to read file" };
+        if (status == -1) {
+            out.error("Failed to open file");
+            return -1;
+        }
+        if (status != 0) {
+            out.error("Failed to read file");
+            return -1;
         }
 
-        return { 0, content };
+        return 0;
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
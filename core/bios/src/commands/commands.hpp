@@ -1,5 +1,9 @@
 #pragma once
+#include "arena.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace commands {
     struct CommandResult {
@@ -7,15 +11,104 @@ namespace commands {
         std::string output;
     };
 
-    // Command function type definition
-    typedef CommandResult (*CommandFunction)(const std::string& args);
+    // Destination for command output; commands write as they produce it
+    class OutputSink {
+    public:
+        virtual ~OutputSink() = default;
+        virtual void write(std::string_view data) = 0;
+        // Error and usage messages. Shown inline with the output unless a sink keeps them
+        // apart (the WASI program's stderr; a pipeline stage's or a redirect's errors
+        // bypass the next stage or the file).
+        virtual void error(std::string_view message) { write(message); }
+    };
+
+    // Collects all output into one string (backs the CommandResult API)
+    class StringSink : public OutputSink {
+    public:
+        std::string output;
+        void write(std::string_view data) override { output.append(data); }
+    };
+
+    // Batches writes into fixed-size chunks and hands each full chunk to a flush callback
+    class ChunkedSink : public OutputSink {
+    public:
+        typedef void (*FlushFunction)(const char* data, size_t len, void* context);
+
+        ChunkedSink(FlushFunction flush, void* context = nullptr, size_t chunk_size = 64 * 1024);
+        ~ChunkedSink() override;
+
+        void write(std::string_view data) override;
+        void flush();
+
+    private:
+        FlushFunction flush_fn;
+        void* context;
+        std::string buffer;
+        size_t chunk_size;
+    };
+
+    // Temporaries inside commands use the per-invocation scratch arena, which
+    // execute_command resets when the outermost command returns
+    typedef runtime::ScratchString ScratchString;
+
+    // Input pulled on demand, e.g. a host stdin that only a command actually reading its
+    // input should read (and wait on)
+    class InputSource {
+    public:
+        virtual ~InputSource() = default;
+        // Fill up to cap bytes; returns the byte count, 0 at end of input, -1 on error
+        virtual int64_t read(uint8_t* buffer, size_t cap) = 0;
+    };
+
+    // Standard input of a command: the output of the previous pipeline stage or a
+    // '<' redirection. Commands that take a filename read this instead when it is omitted.
+    // When source is set the input is read from it rather than from data.
+    struct CommandInput {
+        std::string_view data;
+        InputSource* source = nullptr;
+        bool piped = false;
+    };
+
+    // Command function type definition; returns the exit code
+    typedef int (*CommandFunction)(std::string_view args, OutputSink& out, const CommandInput& in);
 
     // Command functions
-    CommandResult ls(const std::string& args);
-    CommandResult cat(const std::string& args);
-    CommandResult echo(const std::string& args);
-    CommandResult rm(const std::string& args);
+    int ls(std::string_view args, OutputSink& out, const CommandInput& in);
+    int cat(std::string_view args, OutputSink& out, const CommandInput& in);
+    int echo(std::string_view args, OutputSink& out, const CommandInput& in);
+    int rm(std::string_view args, OutputSink& out, const CommandInput& in);
+    int grep(std::string_view args, OutputSink& out, const CommandInput& in);
+    int wc(std::string_view args, OutputSink& out, const CommandInput& in);
+    int sha256(std::string_view args, OutputSink& out, const CommandInput& in);
+    int crc32(std::string_view args, OutputSink& out, const CommandInput& in);
+    int gzip(std::string_view args, OutputSink& out, const CommandInput& in);
+    int gunzip(std::string_view args, OutputSink& out, const CommandInput& in);
+    int lz4(std::string_view args, OutputSink& out, const CommandInput& in);
+    int unlz4(std::string_view args, OutputSink& out, const CommandInput& in);
+    // Tree commands share fs::walk; on the threads build, run them through execute_async
+    // so large trees are handled on the worker pool instead of the main thread
+    int cp(std::string_view args, OutputSink& out, const CommandInput& in);
+    int mv(std::string_view args, OutputSink& out, const CommandInput& in);
+    int find(std::string_view args, OutputSink& out, const CommandInput& in);
+    int du(std::string_view args, OutputSink& out, const CommandInput& in);
+
+    // Split arguments on whitespace, honouring '...' and "..." quoting (quotes are stripped).
+    // Fills at most max_args views and returns the total number of arguments found.
+    size_t split_args(std::string_view args, std::string_view* argv, size_t max_args);
+
+    // A command's single path argument: args as-is (spaces included), or the text inside
+    // the quotes when the whole argument is quoted
+    std::string_view path_argument(std::string_view args);
+
+    // Run one registered command by name (no pipeline parsing); unknown names return -1
+    int run_command(std::string_view name, std::string_view args, OutputSink& out, const CommandInput& in);
+
+    // Run a command line: stages joined by |, with > >> < redirections and ; && || lists
+    // (see pipeline.cpp). The whole line runs inside the module; only the final output
+    // reaches out. in is the standard input of the first stage run.
+    int execute_pipeline(std::string_view command_line, OutputSink& out, const CommandInput& in = CommandInput());
 
     // Command registration and execution
-    CommandResult execute_command(const std::string& command);
-} 
\ No newline at end of file
+    int execute_command(std::string_view command, OutputSink& out, const CommandInput& in = CommandInput());
+    CommandResult execute_command(std::string_view command);
+}
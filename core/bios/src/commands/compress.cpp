@@ -0,0 +1,117 @@
+#include "commands.hpp"
+#include "compress.hpp"
+#include "fs.hpp"
+#include "io.hpp"
+
+namespace commands {
+    struct CodecTarget {
+        OutputSink* sink;   // set for -c
+        int handle;
+        bool failed;
+    };
+
+    static void write_target(const uint8_t* data, size_t len, void* context) {
+        auto& target = *static_cast<CodecTarget*>(context);
+        if (target.failed) return;
+        if (target.sink) {
+            target.sink->write(std::string_view(reinterpret_cast<const char*>(data), len));
+        } else if (fs::write_handle(target.handle, data, len) < 0) {
+            target.failed = true;
+        }
+    }
+
+    // Shared driver for gzip/gunzip/lz4/unlz4: [-d] [-c] [-k] [-1..-9] [filename].
+    // Output goes to <filename><suffix> (or has the suffix stripped when decompressing),
+    // or to the command output with -c or when reading piped input. remove_input mirrors the CLI the command is named after.
+    static int run_codec(std::string_view args, OutputSink& out, const CommandInput& in, kernels::Codec codec, bool decompress,
+                         bool remove_input, std::string_view suffix, const char* usage) {
+        std::string_view argv[6];
+        size_t argc = split_args(args, argv, 6);
+
+        bool to_output = false;
+        int level = 0;
+        size_t index = 0;
+        for (; index < argc && index < 6 && argv[index].size() > 1 && argv[index][0] == '-'; ++index) {
+            std::string_view flag = argv[index];
+            if (flag == "-d") decompress = true;
+            else if (flag == "-c") to_output = true;
+            else if (flag == "-k") remove_input = false;
+            else if (flag.size() == 2 && flag[1] >= '1' && flag[1] <= '9') level = flag[1] - '0';
+            else break;
+        }
+
+        const bool from_input = argc == index && in.piped;
+        if (argc > 6 || (argc - index != 1 && !from_input)) {
+            out.error(usage);
+            return -1;
+        }
+        if (from_input) to_output = true;
+
+        const ScratchString path(from_input ? std::string_view() : argv[index]);
+        ScratchString target_path;
+        if (!to_output) {
+            if (decompress) {
+                std::string_view name(path);
+                if (name.size() <= suffix.size() || name.substr(name.size() - suffix.size()) != suffix) {
+                    out.error("Unknown suffix, expected ");
+                    out.error(suffix);
+                    return -1;
+                }
+                target_path.assign(name.substr(0, name.size() - suffix.size()));
+            } else {
+                target_path.assign(path);
+                target_path.append(suffix);
+            }
+        }
+
+        auto stream = decompress ? kernels::make_decompressor(codec) : kernels::make_compressor(codec, level);
+        CodecTarget target { to_output ? &out : nullptr, -1, false };
+        if (!to_output) {
+            target.handle = fs::open_handle(target_path.c_str(), fs::OPEN_WRITE | fs::OPEN_CREATE | fs::OPEN_TRUNCATE);
+            if (target.handle < 0) {
+                out.error("Failed to open output file");
+                return -1;
+            }
+        }
+
+        bool corrupt = false;
+        int status = read_source(path.c_str(), in, [&](const uint8_t* data, size_t len) {
+            if (!corrupt && !target.failed && stream->update(data, len, write_target, &target) != 0) corrupt = true;
+        });
+        if (status == 0 && !corrupt && !target.failed && stream->finish(write_target, &target) != 0) corrupt = true;
+
+        if (!to_output && fs::close_handle(target.handle) != 0) target.failed = true;
+
+        if (status != 0 || corrupt || target.failed) {
+            if (!to_output) fs::remove_file(target_path.c_str());
+            out.error(status == -1 ? "Failed to open file"
+                : status == -2 ? "Failed to read file"
+                : corrupt ? "Invalid or truncated input"
+                : "Failed to write output file");
+            return -1;
+        }
+
+        if (remove_input && !to_output) fs::remove_file(path.c_str());
+        return 0;
+    }
+
+    int gzip(std::string_view args, OutputSink& out, const CommandInput& in) {
+        return run_codec(args, out, in, kernels::Codec::Gzip, false, true, ".gz",
+            "Usage: gzip [-d] [-c] [-k] [-1..-9] [filename]");
+    }
+
+    int gunzip(std::string_view args, OutputSink& out, const CommandInput& in) {
+        return run_codec(args, out, in, kernels::Codec::Gzip, true, true, ".gz",
+            "Usage: gunzip [-c] [-k] [filename]");
+    }
+
+    int lz4(std::string_view args, OutputSink& out, const CommandInput& in) {
+        return run_codec(args, out, in, kernels::Codec::Lz4, false, false, ".lz4",
+            "Usage: lz4 [-d] [-c] [filename]");
+    }
+
+    int unlz4(std::string_view args, OutputSink& out, const CommandInput& in) {
+        return run_codec(args, out, in, kernels::Codec::Lz4, true, false, ".lz4",
+            "Usage: unlz4 [-c] [filename]");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "commands.hpp"
+#include "fs.hpp"
+#include <sys/stat.h>
+
+namespace commands {
+    constexpr size_t max_tree_args = 32;
+
+    static bool is_directory(const char* path) {
+        struct stat st;
+        return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+    }
+
+    // Destination for src: dst itself, or dst/<basename of src> when dst is a directory
+    static ScratchString target_path(std::string_view src, std::string_view dst, bool into_directory) {
+        ScratchString target(dst);
+        if (!into_directory) return target;
+
+        while (src.size() > 1 && src.back() == '/') src.remove_suffix(1);
+        size_t slash = src.rfind('/');
+        if (target.empty() || target.back() != '/') target += '/';
+        target.append(slash == std::string_view::npos ? src : src.substr(slash + 1));
+        return target;
+    }
+
+    typedef int (*TreeOperation)(const char* src, const char* dst);
+
+    // Shared by cp and mv: <src> <dst>, or several sources into an existing directory
+    static int transfer(std::string_view* argv, size_t argc, bool recursive, TreeOperation operation,
+                        const char* failure, OutputSink& out) {
+        const ScratchString dst(argv[argc - 1]);
+        const bool into_directory = is_directory(dst.c_str());
+        if (argc > 2 && !into_directory) {
+            ScratchString message = "Not a directory: ";
+            message += dst;
+            out.error(message);
+            return -1;
+        }
+
+        int status = 0;
+        for (size_t i = 0; i + 1 < argc; ++i) {
+            const ScratchString src(argv[i]);
+            if (!recursive && is_directory(src.c_str())) {
+                ScratchString message = "Omitting directory (use -r): ";
+                message += src;
+                message += '\n';
+                out.error(message);
+                status = -1;
+                continue;
+            }
+
+            const ScratchString target = target_path(src, dst, into_directory);
+            if (operation(src.c_str(), target.c_str()) != 0) {
+                ScratchString message = failure;
+                message += src;
+                message += '\n';
+                out.error(message);
+                status = -1;
+            }
+        }
+        return status;
+    }
+
+    int cp(std::string_view args, OutputSink& out, const CommandInput&) {
+        std::string_view argv[max_tree_args];
+        size_t argc = split_args(args, argv, max_tree_args);
+
+        bool recursive = false;
+        size_t index = 0;
+        for (; index < argc && index < max_tree_args && (argv[index] == "-r" || argv[index] == "-R"); ++index) {
+            recursive = true;
+        }
+
+        if (argc > max_tree_args || argc - index < 2) {
+            out.error("Usage: cp [-r] <source>... <destination>");
+            return -1;
+        }
+
+        return transfer(argv + index, argc - index, recursive, fs::copy_tree, "Failed to copy: ", out);
+    }
+
+    int mv(std::string_view args, OutputSink& out, const CommandInput&) {
+        std::string_view argv[max_tree_args];
+        size_t argc = split_args(args, argv, max_tree_args);
+
+        if (argc > max_tree_args || argc < 2) {
+            out.error("Usage: mv <source>... <destination>");
+            return -1;
+        }
+
+        // rename() moves whole directories, so mv never needs -r
+        return transfer(argv, argc, true, fs::move_path, "Failed to move: ", out);
+    }
+}
\ No newline at end of file
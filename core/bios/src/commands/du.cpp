@@ -0,0 +1,91 @@
+#include "commands.hpp"
+#include "fs.hpp"
+#include "io.hpp"
+#include <sys/stat.h>
+
+namespace commands {
+    // Apparent size in bytes; lazily backed placeholders report their logical size
+    static uint64_t entry_size(const char* path) {
+        struct stat st;
+        if (lstat(path, &st) != 0) return 0;
+        if (S_ISREG(st.st_mode) && st.st_size == 0) {
+            int64_t size = fs::file_size(path);
+            return size > 0 ? static_cast<uint64_t>(size) : 0;
+        }
+        return S_ISREG(st.st_mode) || S_ISLNK(st.st_mode) ? static_cast<uint64_t>(st.st_size) : 0;
+    }
+
+    struct DuState {
+        bool summary = false;
+        // totals[d] accumulates the directory whose children are at walk depth d;
+        // totals[0] is the root
+        runtime::ScratchVector<uint64_t> totals;
+        OutputSink* out = nullptr;
+        ScratchString buffer;
+    };
+
+    static void du_emit(DuState& state, uint64_t size, std::string_view path) {
+        append_number(state.buffer, size);
+        state.buffer += '\t';
+        state.buffer.append(path.data(), path.size());
+        state.buffer += '\n';
+        if (state.buffer.size() >= read_chunk_size) {
+            state.out->write(state.buffer);
+            state.buffer.clear();
+        }
+    }
+
+    static fs::WalkAction du_entry(const fs::WalkEntry& entry, void* data) {
+        auto& state = *static_cast<DuState*>(data);
+        const size_t depth = static_cast<size_t>(entry.depth);
+
+        if (entry.type != fs::EntryType::Directory) {
+            state.totals[depth] += entry_size(entry.path.data());
+        } else if (!entry.post) {
+            if (state.totals.size() < depth + 2) state.totals.resize(depth + 2);
+            state.totals[depth + 1] = 0;
+        } else {
+            // Directories are reported after their contents, like du(1)
+            const uint64_t total = state.totals[depth + 1];
+            if (!state.summary) du_emit(state, total, entry.path);
+            state.totals[depth] += total;
+        }
+        return fs::WalkAction::Continue;
+    }
+
+    int du(std::string_view args, OutputSink& out, const CommandInput&) {
+        DuState state;
+        state.out = &out;
+
+        if (args.size() >= 2 && args.substr(0, 2) == "-s" && (args.size() == 2 || args[2] == ' ' || args[2] == '\t')) {
+            state.summary = true;
+            args.remove_prefix(2);
+            while (!args.empty() && (args[0] == ' ' || args[0] == '\t')) args.remove_prefix(1);
+        }
+
+        const ScratchString path(args.empty() ? std::string_view("/") : path_argument(args));
+        struct stat st;
+        if (lstat(path.c_str(), &st) != 0) {
+            ScratchString message = "No such file or directory: ";
+            message += path;
+            out.error(message);
+            return -1;
+        }
+
+        int status = 0;
+        state.totals.assign(1, 0);
+        if (S_ISDIR(st.st_mode)) {
+            status = fs::walk(path.c_str(), -1, du_entry, &state, fs::WALK_POST_ORDER);
+        } else {
+            state.totals[0] = entry_size(path.c_str());
+        }
+
+        du_emit(state, state.totals[0], path);
+        out.write(state.buffer);
+        if (status != 0) {
+            out.error("Failed to open directory");
+            return -1;
+        }
+        return 0;
+    }
+}
\ No newline at end of file
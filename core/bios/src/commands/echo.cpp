@@ -1,27 +1,27 @@
 #include "commands.hpp"
-#include <emscripten/console.h>
-#include <fstream>
 
 namespace commands {
-    CommandResult echo(const std::string& args) {
-        size_t gt_pos = args.find('>');
-        if (gt_pos != std::string::npos) {
-            std::string content = args.substr(0, gt_pos);
-            std::string filename = args.substr(gt_pos + 1);
-            
-            // Trim whitespace
-            content = content.substr(0, content.find_last_not_of(" \t") + 1);
-            filename = filename.substr(filename.find_first_not_of(" \t"));
-            
-            std::ofstream file(filename);
-            if (!file.is_open()) {
-                return { -1, "Failed to open file for writing" };
+    // Redirection is handled by the pipeline parser; quotes are dropped as in a shell
+    int echo(std::string_view args, OutputSink& out, const CommandInput&) {
+        if (args.find_first_of("\"'") == std::string_view::npos) {
+            out.write(args);
+            return 0;
+        }
+
+        ScratchString text;
+        char quote = 0;
+        for (char c : args) {
+            if (quote) {
+                if (c == quote) quote = 0;
+                else text += c;
+            } else if (c == '"' || c == '\'') {
+                quote = c;
+            } else {
+                text += c;
             }
-            
-            file << content;
-            return { 0, "" };
-        } else {
-            return { 0, args };
         }
+
+        out.write(text);
+        return 0;
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
@@ -1,34 +1,112 @@
 #include "commands.hpp"
-#include <unordered_map>
-#include <emscripten/console.h>
+#include "metrics.hpp"
+#include <algorithm>
+#include <array>
 
 namespace commands {
-    // Command registry
-    static const std::unordered_map<std::string, CommandFunction> command_registry = {
-        {"ls", ls},
+    struct CommandEntry {
+        std::string_view name;
+        CommandFunction function;
+    };
+
+    // Command registry, kept sorted by name for binary search
+    static constexpr CommandEntry command_registry[] = {
         {"cat", cat},
+        {"cp", cp},
+        {"crc32", crc32},
+        {"du", du},
         {"echo", echo},
-        {"rm", rm}
+        {"find", find},
+        {"grep", grep},
+        {"gunzip", gunzip},
+        {"gzip", gzip},
+        {"ls", ls},
+        {"lz4", lz4},
+        {"mv", mv},
+        {"rm", rm},
+        {"sha256", sha256},
+        {"unlz4", unlz4},
+        {"wc", wc}
     };
 
-    CommandResult execute_command(const std::string& command) {
+    static constexpr bool registry_is_sorted() {
+        for (size_t i = 1; i < std::size(command_registry); ++i) {
+            if (!(command_registry[i - 1].name < command_registry[i].name)) return false;
+        }
+        return true;
+    }
+
+    static_assert(registry_is_sorted(), "command_registry must be sorted by name with no duplicates");
+
+    // Per-command metrics, resolved once and indexed like command_registry
+    static runtime::Metric& command_metric(size_t index) {
+        static const auto metrics = [] {
+            std::array<runtime::Metric*, std::size(command_registry)> table {};
+            for (size_t i = 0; i < table.size(); ++i) {
+                table[i] = &runtime::metric(runtime::MetricKind::Command, command_registry[i].name);
+            }
+            return table;
+        }();
+        return *metrics[index];
+    }
+
+    // Forwards to another sink, counting bytes for the command's metrics
+    class CountingSink : public OutputSink {
+    public:
+        explicit CountingSink(OutputSink& inner) : inner(inner) {}
+
+        void write(std::string_view data) override {
+            bytes += data.size();
+            inner.write(data);
+        }
+
+        void error(std::string_view message) override { inner.error(message); }
+
+        OutputSink& inner;
+        size_t bytes = 0;
+    };
+
+    int run_command(std::string_view name, std::string_view args, OutputSink& out, const CommandInput& in) {
+        // Look up command in registry
+        const auto* end = std::end(command_registry);
+        const auto* it = std::lower_bound(std::begin(command_registry), end, name,
+            [](const CommandEntry& entry, std::string_view name) { return entry.name < name; });
+        if (it == end || it->name != name) {
+            out.error("Unknown command");
+            return -1;
+        }
+
+        // Execute command
+        runtime::MetricScope metric(command_metric(static_cast<size_t>(it - std::begin(command_registry))), args.size());
+        CountingSink counter(out);
+        int code = it->function(args, counter, in);
+        metric.add_bytes_out(counter.bytes);
+        return code;
+    }
+
+    int execute_command(std::string_view command, OutputSink& out, const CommandInput& in) {
+        runtime::ScratchScope scratch;
+
         // emscripten_console_log("Command received:");
         // emscripten_console_log(command.c_str());
 
+        // Operators need the pipeline parser; a plain command dispatches directly
+        if (command.find_first_of("|&;<>") != std::string_view::npos) {
+            return execute_pipeline(command, out, in);
+        }
+
         // Split command and arguments
         size_t space_pos = command.find(' ');
-        std::string cmd = space_pos != std::string::npos ? 
-            command.substr(0, space_pos) : command;
-        std::string args = space_pos != std::string::npos ? 
-            command.substr(space_pos + 1) : "";
+        std::string_view cmd = command.substr(0, space_pos);
+        std::string_view args = space_pos != std::string_view::npos ?
+            command.substr(space_pos + 1) : std::string_view();
 
-        // Look up command in registry
-        auto it = command_registry.find(cmd);
-        if (it == command_registry.end()) {
-            return { -1, "Unknown command" };
-        }
+        return run_command(cmd, args, out, in);
+    }
 
-        // Execute command
-        return it->second(args);
+    CommandResult execute_command(std::string_view command) {
+        StringSink sink;
+        int code = execute_command(command, sink);
+        return { code, std::move(sink.output) };
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
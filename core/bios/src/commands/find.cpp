@@ -0,0 +1,110 @@
+#include "commands.hpp"
+#include "fs.hpp"
+#include "io.hpp"
+#include <cstdlib>
+#include <fnmatch.h>
+#include <sys/stat.h>
+
+namespace commands {
+    struct FindState {
+        const char* name_pattern = nullptr;
+        fs::EntryType type = fs::EntryType::Unknown;   // Unknown matches every type
+        OutputSink* out = nullptr;
+        ScratchString buffer;
+    };
+
+    static void find_emit(FindState& state, std::string_view path, std::string_view name, fs::EntryType type) {
+        if (state.type != fs::EntryType::Unknown && type != state.type) return;
+        if (state.name_pattern && fnmatch(state.name_pattern, name.data(), 0) != 0) return;
+
+        state.buffer.append(path.data(), path.size());
+        state.buffer += '\n';
+        if (state.buffer.size() >= read_chunk_size) {
+            state.out->write(state.buffer);
+            state.buffer.clear();
+        }
+    }
+
+    static fs::WalkAction find_entry(const fs::WalkEntry& entry, void* data) {
+        find_emit(*static_cast<FindState*>(data), entry.path, entry.name, entry.type);
+        return fs::WalkAction::Continue;
+    }
+
+    int find(std::string_view args, OutputSink& out, const CommandInput&) {
+        constexpr size_t max_args = 8;
+        std::string_view argv[max_args];
+        size_t argc = split_args(args, argv, max_args);
+
+        FindState state;
+        state.out = &out;
+
+        std::string_view root = "/";
+        size_t index = 0;
+        if (index < argc && index < max_args && !argv[index].empty() && argv[index][0] != '-') root = argv[index++];
+
+        ScratchString pattern;
+        int max_depth = -1;
+        bool valid = argc <= max_args;
+        for (; valid && index < argc; index += 2) {
+            if (index + 1 >= argc) {
+                valid = false;
+            } else if (argv[index] == "-name") {
+                pattern = argv[index + 1];
+                state.name_pattern = pattern.c_str();
+            } else if (argv[index] == "-type" && argv[index + 1].size() == 1) {
+                switch (argv[index + 1][0]) {
+                    case 'f': state.type = fs::EntryType::File; break;
+                    case 'd': state.type = fs::EntryType::Directory; break;
+                    case 'l': state.type = fs::EntryType::Symlink; break;
+                    default: valid = false;
+                }
+            } else if (argv[index] == "-maxdepth") {
+                const ScratchString depth(argv[index + 1]);
+                char* end;
+                max_depth = static_cast<int>(strtol(depth.c_str(), &end, 10));
+                valid = *end == '\0' && max_depth >= 0;
+            } else {
+                valid = false;
+            }
+        }
+
+        if (!valid) {
+            out.error("Usage: find [path] [-name <pattern>] [-type f|d|l] [-maxdepth <n>]");
+            return -1;
+        }
+
+        const ScratchString path(root);
+        struct stat st;
+        if (lstat(path.c_str(), &st) != 0) {
+            ScratchString message = "No such file or directory: ";
+            message += path;
+            out.error(message);
+            return -1;
+        }
+
+        // The root is an entry at depth 0, like find(1); walk depths start at its children
+        const bool is_directory = S_ISDIR(st.st_mode);
+        const fs::EntryType root_type = is_directory ? fs::EntryType::Directory
+                                      : S_ISREG(st.st_mode) ? fs::EntryType::File
+                                      : S_ISLNK(st.st_mode) ? fs::EntryType::Symlink
+                                      : fs::EntryType::Other;
+        // fnmatch needs a NUL-terminated name, so the root's basename gets its own copy
+        std::string_view base(path);
+        while (base.size() > 1 && base.back() == '/') base.remove_suffix(1);
+        if (base.size() > 1) base = base.substr(base.rfind('/') + 1);
+        const ScratchString root_name(base);
+        find_emit(state, path, root_name, root_type);
+
+        int status = 0;
+        if (is_directory && max_depth != 0) {
+            status = fs::walk(path.c_str(), max_depth < 0 ? -1 : max_depth - 1, find_entry, &state);
+        }
+
+        if (!state.buffer.empty()) out.write(state.buffer);
+        if (status != 0) {
+            out.error("Failed to open directory");
+            return -1;
+        }
+        return 0;
+    }
+}
\ No newline at end of file
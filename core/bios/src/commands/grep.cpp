@@ -0,0 +1,121 @@
+#include "commands.hpp"
+#include "io.hpp"
+#include "kernels.hpp"
+
+namespace commands {
+    struct GrepState {
+        std::string_view pattern;
+        bool count_only = false;
+        bool line_numbers = false;
+        uint64_t matches = 0;
+        uint64_t line_no = 0;   // lines fully consumed so far
+        OutputSink* out = nullptr;
+        ScratchString line;
+    };
+
+    // Scan a block made of complete lines (the last line may lack '\n' at EOF)
+    static void grep_block(GrepState& state, const uint8_t* block, size_t len) {
+        const auto* needle = reinterpret_cast<const uint8_t*>(state.pattern.data());
+        size_t pos = 0;
+        while (pos < len) {
+            const uint8_t* match = kernels::find_bytes(block + pos, len - pos, needle, state.pattern.size());
+            if (!match) {
+                if (state.line_numbers) state.line_no += kernels::count_byte(block + pos, len - pos, '\n');
+                return;
+            }
+
+            size_t match_pos = static_cast<size_t>(match - block);
+            size_t line_start = match_pos;
+            while (line_start > pos && block[line_start - 1] != '\n') --line_start;
+            const uint8_t* newline = kernels::find_byte(match, len - match_pos, '\n');
+            size_t line_end = newline ? static_cast<size_t>(newline - block) : len;
+
+            if (state.line_numbers) state.line_no += kernels::count_byte(block + pos, line_start - pos, '\n');
+            ++state.line_no;
+            ++state.matches;
+
+            if (!state.count_only) {
+                state.line.clear();
+                if (state.line_numbers) {
+                    append_number(state.line, state.line_no);
+                    state.line += ':';
+                }
+                state.line.append(reinterpret_cast<const char*>(block + line_start), line_end - line_start);
+                state.line += '\n';
+                state.out->write(state.line);
+            }
+
+            pos = line_end + 1;
+        }
+    }
+
+    // Offset just past the last '\n' in data, or 0 if there is none
+    static size_t complete_prefix(const uint8_t* data, size_t len) {
+        while (len > 0 && data[len - 1] != '\n') --len;
+        return len;
+    }
+
+    int grep(std::string_view args, OutputSink& out, const CommandInput& in) {
+        std::string_view argv[4];
+        size_t argc = split_args(args, argv, 4);
+
+        GrepState state;
+        state.out = &out;
+
+        size_t index = 0;
+        for (; index < argc && index < 4 && argv[index].size() > 1 && argv[index][0] == '-'; ++index) {
+            if (argv[index] == "-c") state.count_only = true;
+            else if (argv[index] == "-n") state.line_numbers = true;
+            else break;
+        }
+
+        const bool from_input = argc - index == 1 && in.piped;
+        if (argc > 4 || (argc - index != 2 && !from_input)) {
+            out.error("Usage: grep [-c] [-n] <pattern> [filename]");
+            return -1;
+        }
+
+        state.pattern = argv[index];
+        const ScratchString path(from_input ? std::string_view() : argv[index + 1]);
+
+        // Scan whole lines straight out of each chunk; only a line split across
+        // chunks is carried over and completed from the next one
+        ScratchString pending;
+        int status = read_source(path.c_str(), in, [&](const uint8_t* data, size_t len) {
+            if (!pending.empty()) {
+                const uint8_t* newline = kernels::find_byte(data, len, '\n');
+                if (!newline) {
+                    pending.append(reinterpret_cast<const char*>(data), len);
+                    return;
+                }
+
+                size_t head = static_cast<size_t>(newline - data) + 1;
+                pending.append(reinterpret_cast<const char*>(data), head);
+                grep_block(state, reinterpret_cast<const uint8_t*>(pending.data()), pending.size());
+                pending.clear();
+                data += head;
+                len -= head;
+            }
+
+            size_t complete = complete_prefix(data, len);
+            grep_block(state, data, complete);
+            pending.assign(reinterpret_cast<const char*>(data + complete), len - complete);
+        });
+
+        if (status != 0) {
+            out.error(status == -1 ? "Failed to open file" : "Failed to read file");
+            return -1;
+        }
+
+        grep_block(state, reinterpret_cast<const uint8_t*>(pending.data()), pending.size());
+
+        if (state.count_only) {
+            ScratchString count;
+            append_number(count, state.matches);
+            count += '\n';
+            out.write(count);
+        }
+
+        return state.matches ? 0 : 1;
+    }
+}
\ No newline at end of file
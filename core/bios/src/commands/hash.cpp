@@ -0,0 +1,74 @@
+#include "commands.hpp"
+#include "io.hpp"
+#include "kernels.hpp"
+
+namespace commands {
+    static const char hex_digits[] = "0123456789abcdef";
+
+    static void append_hex(ScratchString& output, const uint8_t* data, size_t len) {
+        for (size_t i = 0; i < len; ++i) {
+            output += hex_digits[data[i] >> 4];
+            output += hex_digits[data[i] & 0x0F];
+        }
+    }
+
+    int sha256(std::string_view args, OutputSink& out, const CommandInput& in) {
+        if (args.empty() && !in.piped) {
+            out.error("Usage: sha256 <filename>");
+            return -1;
+        }
+
+        kernels::Sha256 hasher;
+        const ScratchString path(path_argument(args));
+        int status = read_source(path.c_str(), in, [&](const uint8_t* data, size_t len) {
+            hasher.update(data, len);
+        });
+
+        if (status != 0) {
+            out.error(status == -1 ? "Failed to open file" : "Failed to read file");
+            return -1;
+        }
+
+        uint8_t digest[32];
+        hasher.finish(digest);
+
+        ScratchString output;
+        append_hex(output, digest, sizeof(digest));
+        output += "  ";
+        output += path.empty() ? std::string_view("-") : std::string_view(path);
+        output += '\n';
+        out.write(output);
+        return 0;
+    }
+
+    int crc32(std::string_view args, OutputSink& out, const CommandInput& in) {
+        if (args.empty() && !in.piped) {
+            out.error("Usage: crc32 <filename>");
+            return -1;
+        }
+
+        uint32_t crc = 0;
+        const ScratchString path(path_argument(args));
+        int status = read_source(path.c_str(), in, [&](const uint8_t* data, size_t len) {
+            crc = kernels::crc32(crc, data, len);
+        });
+
+        if (status != 0) {
+            out.error(status == -1 ? "Failed to open file" : "Failed to read file");
+            return -1;
+        }
+
+        const uint8_t bytes[4] = {
+            static_cast<uint8_t>(crc >> 24), static_cast<uint8_t>(crc >> 16),
+            static_cast<uint8_t>(crc >> 8), static_cast<uint8_t>(crc)
+        };
+
+        ScratchString output;
+        append_hex(output, bytes, sizeof(bytes));
+        output += "  ";
+        output += path.empty() ? std::string_view("-") : std::string_view(path);
+        output += '\n';
+        out.write(output);
+        return 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include "arena.hpp"
+#include "commands.hpp"
+#include "fs.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace commands {
+    constexpr size_t read_chunk_size = 64 * 1024;
+
+    // Feed a file to fn(const uint8_t* data, size_t len) one chunk at a time.
+    // Returns 0 on success, -1 if the file cannot be opened, -2 on a read error.
+    template <typename F>
+    int read_chunks(const char* path, F&& fn) {
+        int handle = fs::open_handle(path);
+        if (handle < 0) return -1;
+
+        runtime::ScratchVector<uint8_t> chunk(read_chunk_size);
+        int64_t n;
+        while ((n = fs::read_handle(handle, chunk.data(), chunk.size())) > 0) {
+            fn(chunk.data(), static_cast<size_t>(n));
+        }
+        fs::close_handle(handle);
+
+        return n < 0 ? -2 : 0;
+    }
+
+    // read_chunks for commands that also accept piped input: an empty path reads the
+    // command's input instead (-1 if nothing was piped in, -2 if its source fails)
+    template <typename F>
+    int read_source(const char* path, const CommandInput& in, F&& fn) {
+        if (*path) return read_chunks(path, fn);
+        if (!in.piped) return -1;
+
+        if (in.source) {
+            runtime::ScratchVector<uint8_t> chunk(read_chunk_size);
+            int64_t n;
+            while ((n = in.source->read(chunk.data(), chunk.size())) > 0) {
+                fn(chunk.data(), static_cast<size_t>(n));
+            }
+            return n < 0 ? -2 : 0;
+        }
+
+        const auto* data = reinterpret_cast<const uint8_t*>(in.data.data());
+        for (size_t pos = 0; pos < in.data.size(); pos += read_chunk_size) {
+            fn(data + pos, std::min(read_chunk_size, in.data.size() - pos));
+        }
+        return 0;
+    }
+
+    // Append a decimal number without going through std::to_string
+    inline void append_number(runtime::ScratchString& out, uint64_t value) {
+        char digits[20];
+        size_t len = 0;
+        do {
+            digits[len++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value);
+        while (len) out += digits[--len];
+    }
+}
@@ -1,39 +1,20 @@
 #include "commands.hpp"
-#include <emscripten/console.h>
-#include <dirent.h>
-#include <sys/stat.h>
+#include "fs.hpp"
 
 namespace commands {
-    CommandResult ls(const std::string& args) {
-        const char* path = args.empty() ? "/" : args.c_str();
+    int ls(std::string_view args, OutputSink& out, const CommandInput&) {
+        const ScratchString dir_path(args.empty() ? std::string_view("/") : path_argument(args));
+        const char* path = dir_path.c_str();
 
-        DIR* dir = opendir(path);
-        if (!dir) {
-            std::string message = "Failed to open directory: ";
+        ScratchString output;
+        if (fs::list_directory(path, output, true) != 0) {
+            ScratchString message = "Failed to open directory: ";
             message += path;
-            return { -1, message };
+            out.error(message);
+            return -1;
         }
 
-        struct dirent* entry;
-        std::string output;
-        while ((entry = readdir(dir)) != nullptr) {
-            std::string full_path = std::string(path);
-            if (full_path.back() != '/') {
-                full_path += '/';
-            }
-            full_path += entry->d_name;
-
-            struct stat st;
-            if (stat(full_path.c_str(), &st) == 0) {
-                std::string entry_type = S_ISDIR(st.st_mode) ? "d" : "-";
-                output += entry_type + " " + entry->d_name + "\n";
-            } else {
-                output += entry->d_name;
-                output += "\n";
-            }
-        }
-
-        closedir(dir);
-        return { 0, output };
+        out.write(output);
+        return 0;
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
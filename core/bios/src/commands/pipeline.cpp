@@ -0,0 +1,285 @@
+#include "commands.hpp"
+#include "fs.hpp"
+#include "io.hpp"
+
+// Command-line parsing and execution for pipelines and command lists:
+//   line     := pipeline ((';' | '&&' | '||') pipeline)* [';']
+//   pipeline := stage ('|' stage)*
+//   stage    := word+ with any number of '> file', '>> file', '< file'
+// Words keep their quotes; commands strip them with split_args. Stages run one after
+// another, each reading the previous stage's output from a heap buffer. Stage data
+// stays off the scratch arena, which only frees when the whole line is done, so a
+// growing buffer would keep every size it passed through.
+namespace commands {
+    enum class TokenKind {
+        Word,
+        Pipe,       // |
+        And,        // &&
+        Or,         // ||
+        Sequence,   // ; or newline
+        Output,     // >
+        Append,     // >>
+        Input       // <
+    };
+
+    struct Token {
+        TokenKind kind;
+        std::string_view text;
+    };
+
+    struct Stage {
+        std::string_view name;
+        ScratchString args;
+        std::string_view output_path;
+        std::string_view input_path;
+        bool append = false;
+    };
+
+    struct Pipeline {
+        TokenKind connector;   // how this pipeline joins the previous one (Sequence for the first)
+        runtime::ScratchVector<Stage> stages;
+    };
+
+    static bool is_operator(char c) {
+        return c == '|' || c == '&' || c == ';' || c == '<' || c == '>' || c == '\n';
+    }
+
+    // Returns false (with a message in error) on an unterminated quote or a lone '&'
+    static bool tokenize(std::string_view line, runtime::ScratchVector<Token>& tokens, ScratchString& error) {
+        size_t i = 0;
+        while (i < line.size()) {
+            const char c = line[i];
+            if (c == ' ' || c == '\t' || c == '\r') {
+                ++i;
+                continue;
+            }
+
+            const bool doubled = i + 1 < line.size() && line[i + 1] == c;
+            if (c == '|') {
+                tokens.push_back({ doubled ? TokenKind::Or : TokenKind::Pipe, line.substr(i, doubled ? 2 : 1) });
+                i += doubled ? 2 : 1;
+            } else if (c == '&') {
+                if (!doubled) {
+                    error = "Syntax error: background jobs (&) are not supported";
+                    return false;
+                }
+                tokens.push_back({ TokenKind::And, line.substr(i, 2) });
+                i += 2;
+            } else if (c == '>') {
+                tokens.push_back({ doubled ? TokenKind::Append : TokenKind::Output, line.substr(i, doubled ? 2 : 1) });
+                i += doubled ? 2 : 1;
+            } else if (c == '<') {
+                tokens.push_back({ TokenKind::Input, line.substr(i, 1) });
+                ++i;
+            } else if (c == ';' || c == '\n') {
+                tokens.push_back({ TokenKind::Sequence, line.substr(i, 1) });
+                ++i;
+            } else {
+                size_t start = i;
+                while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r' && !is_operator(line[i])) {
+                    if (line[i] == '"' || line[i] == '\'') {
+                        const char quote = line[i];
+                        size_t close = line.find(quote, i + 1);
+                        if (close == std::string_view::npos) {
+                            error = "Syntax error: unterminated quote";
+                            return false;
+                        }
+                        i = close;
+                    }
+                    ++i;
+                }
+                tokens.push_back({ TokenKind::Word, line.substr(start, i - start) });
+            }
+        }
+        return true;
+    }
+
+    static bool parse(const runtime::ScratchVector<Token>& tokens, runtime::ScratchVector<Pipeline>& pipelines, ScratchString& error) {
+        auto fail = [&error](std::string_view near) {
+            error = "Syntax error near '";
+            error.append(near.empty() ? std::string_view("end of line") : near);
+            error += '\'';
+            return false;
+        };
+
+        TokenKind connector = TokenKind::Sequence;
+        size_t i = 0;
+        while (i < tokens.size()) {
+            pipelines.push_back({ connector, runtime::ScratchVector<Stage>() });
+            Pipeline& pipeline = pipelines.back();
+
+            // One pipeline: stages separated by '|'
+            while (true) {
+                pipeline.stages.emplace_back();
+                Stage& stage = pipeline.stages.back();
+
+                for (; i < tokens.size(); ++i) {
+                    const Token& token = tokens[i];
+                    if (token.kind == TokenKind::Word) {
+                        if (stage.name.empty()) {
+                            stage.name = token.text;
+                        } else {
+                            if (!stage.args.empty()) stage.args += ' ';
+                            stage.args.append(token.text);
+                        }
+                    } else if (token.kind == TokenKind::Output || token.kind == TokenKind::Append || token.kind == TokenKind::Input) {
+                        if (i + 1 >= tokens.size() || tokens[i + 1].kind != TokenKind::Word) {
+                            return fail(i + 1 < tokens.size() ? tokens[i + 1].text : std::string_view());
+                        }
+                        if (token.kind == TokenKind::Input) {
+                            stage.input_path = tokens[++i].text;
+                        } else {
+                            stage.output_path = tokens[++i].text;
+                            stage.append = token.kind == TokenKind::Append;
+                        }
+                    } else {
+                        break;
+                    }
+                }
+
+                if (stage.name.empty()) return fail(i < tokens.size() ? tokens[i].text : std::string_view());
+                if (i >= tokens.size() || tokens[i].kind != TokenKind::Pipe) break;
+                ++i;
+            }
+
+            if (i >= tokens.size()) break;
+            connector = tokens[i].kind;
+            ++i;
+
+            // A trailing ';' is allowed; a trailing '&&' or '||' is not
+            if (i >= tokens.size() && connector != TokenKind::Sequence) return fail(std::string_view());
+        }
+        return true;
+    }
+
+    // Collects a stage's output for the next stage; errors go straight to the final sink
+    class BufferSink : public OutputSink {
+    public:
+        BufferSink(std::string& buffer, OutputSink& errors) : buffer(buffer), errors(errors) {}
+        void write(std::string_view data) override { buffer.append(data); }
+        void error(std::string_view message) override { errors.error(message); }
+
+    private:
+        std::string& buffer;
+        OutputSink& errors;
+    };
+
+    // Streams a stage's output into a file through the fs handle table; errors are not
+    // written to the file but to the final sink
+    class FileSink : public OutputSink {
+    public:
+        FileSink(const char* path, bool append, OutputSink& errors) : errors(errors) {
+            handle = fs::open_handle(path, fs::OPEN_WRITE | fs::OPEN_CREATE | (append ? fs::OPEN_APPEND : fs::OPEN_TRUNCATE));
+            ok = handle > 0;
+        }
+
+        ~FileSink() override {
+            if (handle > 0) fs::close_handle(handle);
+        }
+
+        void write(std::string_view data) override {
+            if (ok && fs::write_handle(handle, reinterpret_cast<const uint8_t*>(data.data()), data.size()) < 0) ok = false;
+        }
+
+        void error(std::string_view message) override { errors.error(message); }
+
+        bool ok;
+
+    private:
+        int handle;
+        OutputSink& errors;
+    };
+
+    // Redirection targets may be quoted; split_args strips the quotes
+    static ScratchString unquote(std::string_view word) {
+        std::string_view parts[1];
+        split_args(word, parts, 1);
+        return ScratchString(parts[0]);
+    }
+
+    static int run_pipeline(Pipeline& pipeline, OutputSink& out, const CommandInput& input) {
+        // Two buffers swapped between stages, so each keeps its capacity for the next
+        std::string previous;
+        std::string next;
+        int code = 0;
+
+        for (size_t i = 0; i < pipeline.stages.size(); ++i) {
+            Stage& stage = pipeline.stages[i];
+            const bool last = i + 1 == pipeline.stages.size();
+
+            CommandInput in;
+            std::string file_input;
+            if (!stage.input_path.empty()) {
+                const ScratchString path = unquote(stage.input_path);
+                const int64_t size = fs::file_size(path.c_str());
+                if (size > 0) file_input.reserve(static_cast<size_t>(size));
+                int status = read_chunks(path.c_str(), [&](const uint8_t* data, size_t len) {
+                    file_input.append(reinterpret_cast<const char*>(data), len);
+                });
+                if (status != 0) {
+                    out.error(status == -1 ? "Failed to open file" : "Failed to read file");
+                    return -1;
+                }
+                in.data = file_input;
+                in.piped = true;
+            } else if (i > 0) {
+                in.data = previous;
+                in.piped = true;
+            } else {
+                in = input;
+            }
+
+            next.clear();
+            if (!stage.output_path.empty()) {
+                const ScratchString path = unquote(stage.output_path);
+                FileSink file(path.c_str(), stage.append, out);
+                if (!file.ok) {
+                    out.error("Failed to open file for writing");
+                    return -1;
+                }
+
+                code = run_command(stage.name, stage.args, file, in);
+                if (!file.ok) {
+                    out.error("Failed to write file");
+                    return -1;
+                }
+            } else if (last) {
+                code = run_command(stage.name, stage.args, out, in);
+            } else {
+                BufferSink buffer(next, out);
+                code = run_command(stage.name, stage.args, buffer, in);
+
+                // A failed stage's partial output is not data for the next one; its error
+                // has already reached out
+                if (code < 0) return code;
+            }
+
+            previous.swap(next);
+        }
+
+        return code;
+    }
+
+    int execute_pipeline(std::string_view command_line, OutputSink& out, const CommandInput& in) {
+        runtime::ScratchScope scratch;
+
+        ScratchString error;
+        runtime::ScratchVector<Token> tokens;
+        runtime::ScratchVector<Pipeline> pipelines;
+        if (!tokenize(command_line, tokens, error) || !parse(tokens, pipelines, error)) {
+            out.error(error);
+            return -1;
+        }
+
+        // Like a shell reading its stdin, only the first pipeline that runs consumes in
+        int code = 0;
+        CommandInput input = in;
+        for (Pipeline& pipeline : pipelines) {
+            if (pipeline.connector == TokenKind::And && code != 0) continue;
+            if (pipeline.connector == TokenKind::Or && code == 0) continue;
+            code = run_pipeline(pipeline, out, input);
+            input = CommandInput();
+        }
+        return code;
+    }
+}
\ No newline at end of file
@@ -1,16 +1,57 @@
 #include "commands.hpp"
-#include <emscripten/console.h>
+#include "fs.hpp"
+#include <cstdio>
+#include <sys/stat.h>
 
 namespace commands {
-    CommandResult rm(const std::string& args) {
+    int rm(std::string_view args, OutputSink& out, const CommandInput&) {
+        bool recursive = false;
+        bool force = false;
+
+        // Leading -r / -f / -rf flags; the rest of the line is the path, as before
+        while (args.size() > 1 && args[0] == '-') {
+            size_t end = args.find_first_of(" \t");
+            std::string_view flags = args.substr(1, end == std::string_view::npos ? std::string_view::npos : end - 1);
+            for (char flag : flags) {
+                if (flag == 'r' || flag == 'R') recursive = true;
+                else if (flag == 'f') force = true;
+                else {
+                    out.error("Usage: rm [-r] [-f] <path>");
+                    return -1;
+                }
+            }
+            args = end == std::string_view::npos ? std::string_view() : args.substr(end);
+            while (!args.empty() && (args[0] == ' ' || args[0] == '\t')) args.remove_prefix(1);
+        }
+
         if (args.empty()) {
-            return { -1, "Usage: rm <filename>" };
+            out.error("Usage: rm [-r] [-f] <path>");
+            return -1;
+        }
+
+        const ScratchString path(path_argument(args));
+        struct stat st;
+        if (lstat(path.c_str(), &st) != 0) {
+            if (force) return 0;
+            out.error("Failed to delete file");
+            return -1;
+        }
+
+        if (S_ISDIR(st.st_mode) && recursive) {
+            if (path.find_first_not_of('/') == ScratchString::npos) {
+                out.error("rm: refusing to remove '/'");
+                return -1;
+            }
+            if (fs::remove_tree(path.c_str()) == 0) return 0;
+            out.error("Failed to delete directory");
+            return -1;
         }
 
-        if (remove(args.c_str()) == 0) {
-            return { 0, "" };
+        if (fs::remove_file(path.c_str()) == 0) {
+            return 0;
         } else {
-            return { -1, "Failed to delete file" };
+            out.error(S_ISDIR(st.st_mode) ? "Failed to delete directory (use -r for a non-empty one)" : "Failed to delete file");
+            return -1;
         }
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
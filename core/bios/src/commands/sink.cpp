@@ -0,0 +1,35 @@
+#include "commands.hpp"
+#include <algorithm>
+
+namespace commands {
+    ChunkedSink::ChunkedSink(FlushFunction flush, void* context, size_t chunk_size)
+        : flush_fn(flush), context(context), chunk_size(chunk_size ? chunk_size : 1) {
+        buffer.reserve(this->chunk_size);
+    }
+
+    ChunkedSink::~ChunkedSink() {
+        flush();
+    }
+
+    void ChunkedSink::write(std::string_view data) {
+        while (!data.empty()) {
+            // Large writes skip the buffer once it is empty
+            if (buffer.empty() && data.size() >= chunk_size) {
+                flush_fn(data.data(), chunk_size, context);
+                data.remove_prefix(chunk_size);
+                continue;
+            }
+
+            size_t take = std::min(chunk_size - buffer.size(), data.size());
+            buffer.append(data.data(), take);
+            data.remove_prefix(take);
+            if (buffer.size() == chunk_size) flush();
+        }
+    }
+
+    void ChunkedSink::flush() {
+        if (buffer.empty()) return;
+        flush_fn(buffer.data(), buffer.size(), context);
+        buffer.clear();
+    }
+}
@@ -0,0 +1,52 @@
+#include "commands.hpp"
+#include "io.hpp"
+#include "kernels.hpp"
+
+namespace commands {
+    int wc(std::string_view args, OutputSink& out, const CommandInput& in) {
+        std::string_view argv[5];
+        size_t argc = split_args(args, argv, 5);
+
+        bool lines = false, words = false, bytes = false;
+        size_t index = 0;
+        for (; index < argc && index < 5 && argv[index].size() > 1 && argv[index][0] == '-'; ++index) {
+            for (char flag : argv[index].substr(1)) {
+                if (flag == 'l') lines = true;
+                else if (flag == 'w') words = true;
+                else if (flag == 'c') bytes = true;
+                else {
+                    out.error("Usage: wc [-l] [-w] [-c] [filename]");
+                    return -1;
+                }
+            }
+        }
+
+        const bool from_input = argc == index && in.piped;
+        if (argc > 5 || (argc - index != 1 && !from_input)) {
+            out.error("Usage: wc [-l] [-w] [-c] [filename]");
+            return -1;
+        }
+        if (!lines && !words && !bytes) lines = words = bytes = true;
+
+        kernels::TextCounter counter;
+        const ScratchString path(from_input ? std::string_view() : argv[index]);
+        int status = read_source(path.c_str(), in, [&](const uint8_t* data, size_t len) {
+            counter.update(data, len);
+        });
+
+        if (status != 0) {
+            out.error(status == -1 ? "Failed to open file" : "Failed to read file");
+            return -1;
+        }
+
+        ScratchString output;
+        if (lines) { append_number(output, counter.lines); output += ' '; }
+        if (words) { append_number(output, counter.words); output += ' '; }
+        if (bytes) { append_number(output, counter.bytes); output += ' '; }
+        if (path.empty()) output.pop_back();
+        output += path;
+        output += '\n';
+        out.write(output);
+        return 0;
+    }
+}
\ No newline at end of file
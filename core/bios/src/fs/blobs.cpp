@@ -0,0 +1,95 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include "kernels.hpp"
+#include "platform.hpp"
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+namespace fs {
+    // Blobs are keyed by XXH64 of their bytes; a hash match is confirmed with memcmp,
+    // so a collision only costs a second blob, never a wrong file
+    static runtime::Mutex blob_mutex;
+    static std::unordered_multimap<uint64_t, std::unique_ptr<Blob>> blobs;
+    static size_t dedup_threshold = 0;
+    static uint64_t blob_references = 0;
+    static uint64_t stored_bytes = 0;
+    static uint64_t logical_bytes = 0;
+    static uint64_t dedup_hits = 0;
+
+    const Blob* blob_acquire(const uint8_t* data, size_t len) {
+        // Hash outside the lock; it is the only pass over the bytes on a hit
+        const uint64_t hash = kernels::xxh64(data, len);
+
+        runtime::LockGuard lock(blob_mutex);
+        auto range = blobs.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            Blob& blob = *it->second;
+            if (blob.bytes.size() == len && (len == 0 || memcmp(blob.bytes.data(), data, len) == 0)) {
+                ++blob.refs;
+                ++blob_references;
+                ++dedup_hits;
+                logical_bytes += len;
+                return &blob;
+            }
+        }
+
+        std::unique_ptr<Blob> blob(new Blob { hash, std::vector<uint8_t>(data, data + len), 1 });
+        const Blob* stored = blob.get();
+        blobs.emplace(hash, std::move(blob));
+        ++blob_references;
+        stored_bytes += len;
+        logical_bytes += len;
+        return stored;
+    }
+
+    void blob_retain(const Blob* blob) {
+        runtime::LockGuard lock(blob_mutex);
+        ++const_cast<Blob*>(blob)->refs;
+        ++blob_references;
+        ++dedup_hits;
+        logical_bytes += blob->bytes.size();
+    }
+
+    void blob_release(const Blob* blob) {
+        runtime::LockGuard lock(blob_mutex);
+        --blob_references;
+        logical_bytes -= blob->bytes.size();
+        if (--const_cast<Blob*>(blob)->refs) return;
+
+        auto range = blobs.equal_range(blob->hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.get() == blob) {
+                stored_bytes -= blob->bytes.size();
+                blobs.erase(it);
+                return;
+            }
+        }
+    }
+
+    void set_dedup_threshold(size_t min_bytes) {
+        runtime::LockGuard lock(blob_mutex);
+        dedup_threshold = min_bytes;
+    }
+
+    size_t dedup_min_bytes() {
+        runtime::LockGuard lock(blob_mutex);
+        return dedup_threshold;
+    }
+
+    DedupStats dedup_stats() {
+        runtime::LockGuard lock(blob_mutex);
+        return DedupStats { static_cast<uint64_t>(blobs.size()), blob_references, stored_bytes, logical_bytes, dedup_hits };
+    }
+
+    int write_shared(const char* path, const uint8_t* data, size_t len) {
+        if (!path || (!data && len > 0)) return -1;
+
+        const Blob* blob = blob_acquire(data, len);
+        if (lazy_mount_blob(path, blob) != 0) {
+            blob_release(blob);
+            return -1;
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,197 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include "lru.hpp"
+#include "platform.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace fs {
+    struct BlockKey {
+        std::string path;
+        int64_t block;
+
+        bool operator==(const BlockKey& other) const {
+            return block == other.block && path == other.path;
+        }
+    };
+
+    struct BlockKeyHash {
+        size_t operator()(const BlockKey& key) const {
+            return std::hash<std::string>()(key.path) ^ (static_cast<size_t>(key.block) * 0x9e3779b97f4a7c15ull);
+        }
+    };
+
+    static runtime::Mutex cache_mutex;
+    static LruCache<BlockKey, std::vector<uint8_t>, BlockKeyHash> blocks;
+    static size_t cache_budget = 8 * 1024 * 1024;
+    static size_t cache_resident = 0;
+    static uint64_t cache_hits = 0;
+    static uint64_t cache_misses = 0;
+    static uint64_t cache_evictions = 0;
+    // Bumped on every invalidation so a fetch that raced with a write is not inserted
+    static uint64_t cache_generation = 0;
+    // Cached block count per path, ordered so notify_changed can rule out a path and
+    // everything below it with two lookups instead of scanning every block
+    static std::map<std::string, size_t> cached_paths;
+
+    static void forget_block(const BlockKey& key) {
+        auto it = cached_paths.find(key.path);
+        if (it != cached_paths.end() && --it->second == 0) cached_paths.erase(it);
+    }
+
+    static bool has_cached(std::string_view path) {
+        if (path.empty()) return !cached_paths.empty();
+
+        std::string prefix(path);
+        if (prefix.back() != '/') {
+            if (cached_paths.count(prefix)) return true;
+            prefix += '/';
+        }
+        auto it = cached_paths.lower_bound(prefix);
+        return it != cached_paths.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    static void evict_for(size_t incoming) {
+        BlockKey key;
+        std::vector<uint8_t> block;
+        while (cache_resident + incoming > cache_budget && blocks.evict(key, block)) {
+            cache_resident -= block.size();
+            ++cache_evictions;
+            forget_block(key);
+        }
+    }
+
+    // Drops path and, when it is a directory, everything below it
+    static void drop_path(const char* path) {
+        const std::string_view prefix(path);
+        if (!has_cached(prefix)) return;
+
+        blocks.erase_if(
+            [prefix](const BlockKey& key, const std::vector<uint8_t>&) {
+                if (key.path.compare(0, prefix.size(), prefix) != 0) return false;
+                return key.path.size() == prefix.size() || prefix.empty() || prefix.back() == '/' ||
+                       key.path[prefix.size()] == '/';
+            },
+            [](const BlockKey& key, const std::vector<uint8_t>& block) {
+                cache_resident -= block.size();
+                forget_block(key);
+            });
+    }
+
+    void notify_changed(const char* path, ChangeOp op) {
+        dentry_invalidate(path);
+        journal_append(path, op);
+
+        runtime::LockGuard lock(cache_mutex);
+        ++cache_generation;
+        if (blocks.size()) drop_path(path);
+    }
+
+    void invalidate_cached(const char* path) {
+        dentry_invalidate(path);
+
+        runtime::LockGuard lock(cache_mutex);
+        ++cache_generation;
+        if (path) {
+            drop_path(path);
+        } else {
+            blocks.clear();
+            cached_paths.clear();
+            cache_resident = 0;
+        }
+    }
+
+    void set_block_cache_budget(size_t bytes) {
+        runtime::LockGuard lock(cache_mutex);
+        cache_budget = bytes;
+        evict_for(0);
+    }
+
+    CacheStats block_cache_stats() {
+        runtime::LockGuard lock(cache_mutex);
+        return CacheStats { cache_hits, cache_misses, cache_evictions, cache_resident, cache_budget };
+    }
+
+    int64_t cached_read(const char* path, int fd, int64_t offset, uint8_t* buffer, size_t len) {
+        if (!path || offset < 0 || (!buffer && len > 0)) return -1;
+
+        int owned = -1;
+        size_t copied = 0;
+        runtime::UniqueLock lock(cache_mutex);
+        while (copied < len) {
+            int64_t position = offset + static_cast<int64_t>(copied);
+            BlockKey key { path, position / static_cast<int64_t>(cache_block_size) };
+            size_t block_offset = static_cast<size_t>(position % static_cast<int64_t>(cache_block_size));
+
+            std::vector<uint8_t>* data = blocks.get(key);
+            if (data) {
+                ++cache_hits;
+            } else {
+                ++cache_misses;
+                uint64_t generation = cache_generation;
+                size_t budget = cache_budget;
+                lock.unlock();
+
+                if (fd < 0) {
+                    fd = owned = open(path, O_RDONLY);
+                    if (fd < 0) return -1;
+                }
+
+                // Files that would crowd out the rest of the cache are read straight through
+                struct stat st;
+                if (fstat(fd, &st) != 0 || S_ISDIR(st.st_mode)) {
+                    if (owned >= 0) close(owned);
+                    return -1;
+                }
+                if (static_cast<size_t>(st.st_size) > budget / 4) {
+                    int64_t n = read_fully(fd, buffer + copied, len - copied, position);
+                    if (owned >= 0) close(owned);
+                    return n < 0 ? (copied ? static_cast<int64_t>(copied) : -1) : static_cast<int64_t>(copied) + n;
+                }
+
+                std::vector<uint8_t> fetched(cache_block_size);
+                int64_t n = read_fully(fd, fetched.data(), fetched.size(), key.block * static_cast<int64_t>(cache_block_size));
+                if (n < 0) {
+                    if (owned >= 0) close(owned);
+                    return copied ? static_cast<int64_t>(copied) : -1;
+                }
+                fetched.resize(static_cast<size_t>(n));
+                fetched.shrink_to_fit();
+
+                lock.lock();
+                if (generation != cache_generation) {
+                    // Invalidated mid-fetch: serve this read from the bytes we have, skip caching
+                    size_t take = block_offset < fetched.size() ? std::min(fetched.size() - block_offset, len - copied) : 0;
+                    memcpy(buffer + copied, fetched.data() + block_offset, take);
+                    copied += take;
+                    if (take == 0 || fetched.size() < cache_block_size) break;
+                    continue;
+                }
+
+                // Another reader may have cached the same block while the lock was dropped
+                data = blocks.get(key);
+                if (!data) {
+                    evict_for(fetched.size());
+                    cache_resident += fetched.size();
+                    ++cached_paths[key.path];
+                    data = &blocks.put(key, std::move(fetched));
+                }
+            }
+
+            if (block_offset >= data->size()) break;  // past EOF
+            size_t take = std::min(data->size() - block_offset, len - copied);
+            memcpy(buffer + copied, data->data() + block_offset, take);
+            copied += take;
+            if (data->size() < cache_block_size) break;  // short block is the last one
+        }
+
+        lock.unlock();
+        if (owned >= 0) close(owned);
+        return static_cast<int64_t>(copied);
+    }
+}
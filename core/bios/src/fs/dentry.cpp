@@ -0,0 +1,160 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include "platform.hpp"
+#include <sys/stat.h>
+#include <unordered_map>
+
+namespace fs {
+    // lstat results keyed by canonical absolute path, including negative entries. A
+    // path is only cached once its parent is cached as a real directory, so:
+    //   - a cached entry's ancestors are all cached directories, and dropping a
+    //     directory's subtree is enough to forget everything resolved through it
+    //   - paths reached through a symlinked directory are never cached, so writes
+    //     through one spelling cannot leave a stale entry under another
+    // Filling it up clears it rather than evicting, which would break the first rule, and
+    // the lookup that found it full caches nothing.
+    struct Dentry {
+        bool exists;
+        EntryType type;
+        uint32_t mode;
+        int64_t size;
+    };
+
+    constexpr size_t dentry_capacity = 64 * 1024;
+
+    static runtime::Mutex dentry_mutex;
+    static std::unordered_map<std::string, Dentry> dentries;
+    // Bumped on every invalidation so a lookup that raced with a write is not inserted
+    static uint64_t dentry_generation = 0;
+    static uint64_t dentry_hits = 0;
+    static uint64_t dentry_misses = 0;
+
+    // Absolute, no empty, "." or ".." components and no trailing '/'
+    static bool canonical(std::string_view path) {
+        if (path.size() < 2 || path[0] != '/' || path.back() == '/') return false;
+        for (size_t start = 1; start <= path.size();) {
+            size_t end = path.find('/', start);
+            if (end == std::string_view::npos) end = path.size();
+            std::string_view part = path.substr(start, end - start);
+            if (part.empty() || part == "." || part == "..") return false;
+            start = end + 1;
+        }
+        return true;
+    }
+
+    static EntryType type_of(mode_t mode) {
+        if (S_ISDIR(mode)) return EntryType::Directory;
+        if (S_ISREG(mode)) return EntryType::File;
+        if (S_ISLNK(mode)) return EntryType::Symlink;
+        return EntryType::Other;
+    }
+
+    // lstat-level answer for a canonical path; false when it cannot come from the cache.
+    // The lock is never held across lstat: on a pthread, MEMFS calls are proxied to the
+    // main thread, which may itself be waiting on the lock.
+    static bool resolve(const std::string& path, Dentry& out) {
+        uint64_t generation;
+        {
+            runtime::LockGuard lock(dentry_mutex);
+            auto it = dentries.find(path);
+            if (it != dentries.end()) {
+                ++dentry_hits;
+                out = it->second;
+                return true;
+            }
+            ++dentry_misses;
+            generation = dentry_generation;
+        }
+
+        const size_t slash = path.rfind('/');
+        if (slash > 0) {
+            Dentry parent;
+            if (!resolve(path.substr(0, slash), parent)) return false;
+            if (parent.type == EntryType::Symlink) return false;
+            if (!parent.exists || parent.type != EntryType::Directory) {
+                // Missing because the parent is; not cached, since creating the parent
+                // would not invalidate this path
+                out = Dentry { false, EntryType::Unknown, 0, 0 };
+                return true;
+            }
+        }
+
+        struct stat st;
+        if (lstat(path.c_str(), &st) == 0) {
+            out = Dentry { true, type_of(st.st_mode), static_cast<uint32_t>(st.st_mode), static_cast<int64_t>(st.st_size) };
+            if (out.type == EntryType::File && st.st_size == 0) {
+                int id = lazy_id(path.c_str());
+                if (id >= 0) out.size = lazy_size(id);
+            }
+        } else {
+            out = Dentry { false, EntryType::Unknown, 0, 0 };
+        }
+
+        // A full cache is cleared without inserting path, whose parent went with it. The
+        // generation bump stops other lookups in flight from caching children of the
+        // directories just dropped.
+        runtime::LockGuard lock(dentry_mutex);
+        if (generation == dentry_generation) {
+            if (dentries.size() >= dentry_capacity) {
+                dentries.clear();
+                ++dentry_generation;
+            } else {
+                dentries.emplace(path, out);
+            }
+        }
+        return true;
+    }
+
+    int lookup_path(const char* path, PathInfo* info) {
+        if (!path) return -1;
+
+        Dentry entry;
+        const std::string key(path);
+        if (canonical(key) && resolve(key, entry) && entry.type != EntryType::Symlink) {
+            if (!entry.exists) return 0;
+            if (info) *info = PathInfo { entry.type, entry.mode, entry.size };
+            return 1;
+        }
+
+        // Uncacheable spelling, or a symlink to follow: ask the file system
+        struct stat st;
+        if (stat(path, &st) != 0) return 0;
+        if (info) *info = PathInfo { type_of(st.st_mode), static_cast<uint32_t>(st.st_mode), static_cast<int64_t>(st.st_size) };
+        return 1;
+    }
+
+    void dentry_invalidate(const char* path) {
+        runtime::LockGuard lock(dentry_mutex);
+        ++dentry_generation;
+        if (dentries.empty()) return;
+
+        std::string key(path ? path : "");
+        while (key.size() > 1 && key.back() == '/') key.pop_back();
+        if (!canonical(key)) {
+            // Relative or unusual spelling: cannot tell what it aliases
+            dentries.clear();
+            return;
+        }
+
+        auto it = dentries.find(key);
+        if (it == dentries.end()) return;
+
+        const bool directory = it->second.exists && it->second.type == EntryType::Directory;
+        dentries.erase(it);
+        if (!directory) return;
+
+        key += '/';
+        for (auto child = dentries.begin(); child != dentries.end();) {
+            if (child->first.compare(0, key.size(), key) == 0) {
+                child = dentries.erase(child);
+            } else {
+                ++child;
+            }
+        }
+    }
+
+    DentryStats dentry_cache_stats() {
+        runtime::LockGuard lock(dentry_mutex);
+        return DentryStats { dentry_hits, dentry_misses, static_cast<uint64_t>(dentries.size()) };
+    }
+}
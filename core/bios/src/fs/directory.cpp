@@ -0,0 +1,138 @@
+#include "fs.hpp"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <vector>
+
+namespace fs {
+    static EntryType type_from_mode(mode_t mode) {
+        if (S_ISDIR(mode)) return EntryType::Directory;
+        if (S_ISREG(mode)) return EntryType::File;
+        if (S_ISLNK(mode)) return EntryType::Symlink;
+        return EntryType::Other;
+    }
+
+    static EntryType type_from_dirent(const struct dirent* entry) {
+#ifdef _DIRENT_HAVE_D_TYPE
+        switch (entry->d_type) {
+            case DT_DIR: return EntryType::Directory;
+            case DT_REG: return EntryType::File;
+            case DT_LNK: return EntryType::Symlink;
+            case DT_UNKNOWN: return EntryType::Unknown;
+            default: return EntryType::Other;
+        }
+#else
+        (void)entry;
+        return EntryType::Unknown;
+#endif
+    }
+
+    int for_each_entry(const char* path, EntryCallback callback, void* context, bool resolve_types) {
+        if (!path || !callback) return -1;
+
+        DIR* dir = opendir(path);
+        if (!dir) return -1;
+
+        // Reused for the stat fallback so entries do not each build a path
+        std::string full_path(path);
+        if (full_path.empty() || full_path.back() != '/') full_path += '/';
+        const size_t base_len = full_path.size();
+
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            DirEntry item { entry->d_name, EntryType::Unknown };
+
+            if (resolve_types) {
+                item.type = type_from_dirent(entry);
+
+                // Fall back to stat only when d_type cannot answer; links are followed like stat
+                if (item.type == EntryType::Unknown || item.type == EntryType::Symlink) {
+                    full_path.resize(base_len);
+                    full_path += entry->d_name;
+
+                    struct stat st;
+                    item.type = stat(full_path.c_str(), &st) == 0 ? type_from_mode(st.st_mode) : EntryType::Unknown;
+                }
+            }
+
+            callback(item, context);
+        }
+
+        closedir(dir);
+        return 0;
+    }
+
+    int walk(const char* root, int max_depth, WalkCallback callback, void* context, int flags) {
+        if (!root || !callback) return -1;
+
+        struct Frame {
+            DIR* dir;
+            size_t path_len;  // length of path (with trailing '/') for this directory
+            int depth;
+        };
+
+        std::string path(root);
+        if (path.empty() || path.back() != '/') path += '/';
+        const size_t root_len = path.size();
+
+        DIR* root_dir = opendir(root);
+        if (!root_dir) return -1;
+
+        std::vector<Frame> stack;
+        stack.push_back({ root_dir, root_len, 0 });
+
+        bool stopped = false;
+        while (!stack.empty() && !stopped) {
+            Frame& frame = stack.back();
+            struct dirent* entry = readdir(frame.dir);
+            if (!entry) {
+                closedir(frame.dir);
+                const size_t dir_len = frame.path_len - 1;
+                const int depth = frame.depth - 1;
+                stack.pop_back();
+
+                // The root itself is not an entry; callers handle it around the walk
+                if ((flags & WALK_POST_ORDER) && !stack.empty()) {
+                    path.resize(dir_len);
+                    std::string_view full(path);
+                    WalkEntry item { full, full.substr(root_len), full.substr(stack.back().path_len),
+                                     EntryType::Directory, depth, true };
+                    if (callback(item, context) == WalkAction::Stop) stopped = true;
+                }
+                continue;
+            }
+
+            const char* name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+
+            path.resize(frame.path_len);
+            path += name;
+
+            EntryType type = type_from_dirent(entry);
+            if (type == EntryType::Unknown) {
+                struct stat st;
+                if (lstat(path.c_str(), &st) == 0) type = type_from_mode(st.st_mode);
+            }
+
+            std::string_view full(path);
+            WalkEntry item { full, full.substr(root_len), full.substr(frame.path_len), type, frame.depth };
+            WalkAction action = callback(item, context);
+            if (action == WalkAction::Stop) {
+                stopped = true;
+                continue;
+            }
+
+            if (type == EntryType::Directory && action != WalkAction::Skip &&
+                (max_depth < 0 || frame.depth < max_depth)) {
+                int depth = frame.depth + 1;
+                DIR* child = opendir(path.c_str());
+                if (child) {
+                    path += '/';
+                    stack.push_back({ child, path.size(), depth });
+                }
+            }
+        }
+
+        for (Frame& frame : stack) closedir(frame.dir);
+        return 0;
+    }
+}
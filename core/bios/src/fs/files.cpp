@@ -0,0 +1,121 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs {
+    int64_t read_fully(int fd, uint8_t* buffer, size_t len, int64_t offset) {
+        size_t total = 0;
+        while (total < len) {
+            ssize_t n = offset < 0
+                ? read(fd, buffer + total, len - total)
+                : pread(fd, buffer + total, len - total, static_cast<off_t>(offset + total));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return -1;
+            }
+            if (n == 0) break;
+            total += static_cast<size_t>(n);
+        }
+        return static_cast<int64_t>(total);
+    }
+
+    int write_fully(int fd, const uint8_t* data, size_t len) {
+        size_t written = 0;
+        while (written < len) {
+            ssize_t n = write(fd, data + written, len - written);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return -1;
+            }
+            written += static_cast<size_t>(n);
+        }
+        return 0;
+    }
+
+    int write_bytes(const char* path, const uint8_t* data, size_t len, bool append) {
+        if (!path || (!data && len > 0)) return -1;
+
+        const size_t dedup = append ? 0 : dedup_min_bytes();
+        if (dedup && len >= dedup) return write_shared(path, data, len);
+
+        // Appending needs the real bytes underneath; a truncating write replaces them
+        if (lazy_id(path) >= 0) {
+            if (append ? lazy_materialize(path) != 0 : lazy_unmount(path) != 0) return -1;
+        }
+
+        int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+        int fd = open(path, flags, 0644);
+        if (fd < 0) return -1;
+
+        int status = write_fully(fd, data, len);
+        if (close(fd) != 0) status = -1;
+        notify_changed(path);
+        return status;
+    }
+
+    int64_t file_size(const char* path) {
+        int lazy = lazy_id(path);
+        if (lazy >= 0) return lazy_size(lazy);
+
+        struct stat st;
+        if (!path || stat(path, &st) != 0 || S_ISDIR(st.st_mode)) return -1;
+        return static_cast<int64_t>(st.st_size);
+    }
+
+    int64_t read_into(const char* path, uint8_t* buffer, size_t cap) {
+        return read_range(path, 0, buffer, cap);
+    }
+
+    int64_t read_range(const char* path, int64_t offset, uint8_t* buffer, size_t len) {
+        if (!path || offset < 0 || (!buffer && len > 0)) return -1;
+
+        int lazy = lazy_id(path);
+        if (lazy >= 0) return lazy_read(lazy, offset, buffer, len);
+
+        return cached_read(path, -1, offset, buffer, len);
+    }
+
+    int read_all(const char* path, std::string& out) {
+        if (!path) return -1;
+
+        int lazy = lazy_id(path);
+        if (lazy >= 0) {
+            out.resize(static_cast<size_t>(lazy_size(lazy)));
+            int64_t n = lazy_read(lazy, 0, reinterpret_cast<uint8_t*>(&out[0]), out.size());
+            if (n < 0) return -1;
+            out.resize(static_cast<size_t>(n));
+            return 0;
+        }
+
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return -1;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || S_ISDIR(st.st_mode)) {
+            close(fd);
+            return -1;
+        }
+
+        out.resize(static_cast<size_t>(st.st_size));
+        int64_t n = cached_read(path, fd, 0, reinterpret_cast<uint8_t*>(&out[0]), out.size());
+        close(fd);
+        if (n < 0) return -1;
+
+        out.resize(static_cast<size_t>(n));
+        return 0;
+    }
+
+    int remove_file(const char* path) {
+        if (!path) return -1;
+        // Drop the lazy or blob backing only once the file is gone; a failed remove (a
+        // directory, EACCES) leaves the file as it was
+        int status = remove(path) == 0 ? 0 : -1;
+        if (status == 0) lazy_unmount(path);
+        notify_changed(path, status == 0 ? ChangeOp::Remove : ChangeOp::None);
+        return status;
+    }
+}
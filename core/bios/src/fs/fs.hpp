@@ -0,0 +1,236 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs {
+    // Write a byte span to a file in one unbuffered pass (no strlen, no stream).
+    // Truncates the file unless append is set. Returns 0 on success, -1 on failure.
+    int write_bytes(const char* path, const uint8_t* data, size_t len, bool append = false);
+
+    // Size of a file in bytes, or -1 if it cannot be stat'd
+    int64_t file_size(const char* path);
+
+    // Read up to cap bytes of a file into a caller-owned buffer.
+    // Returns the number of bytes read, or -1 on failure.
+    int64_t read_into(const char* path, uint8_t* buffer, size_t cap);
+
+    // Read up to len bytes starting at offset into a caller-owned buffer.
+    // Returns the number of bytes read (0 past EOF), or -1 on failure.
+    int64_t read_range(const char* path, int64_t offset, uint8_t* buffer, size_t len);
+
+    // Read a whole file into out, sized once up front. Returns 0 on success, -1 on failure.
+    int read_all(const char* path, std::string& out);
+
+    // Remove a file, dropping any lazy backing for it. Returns 0 on success, -1 on failure.
+    int remove_file(const char* path);
+
+    // Fetch len bytes at offset into dest from the lazy backend (e.g. a JS callback).
+    // Returns the number of bytes produced (short only at EOF), or -1 on failure.
+    typedef int64_t (*PageSource)(const char* path, int64_t offset, size_t len, uint8_t* dest);
+
+    void set_page_source(PageSource source);
+
+    // Register a path whose contents live in the page source. An empty placeholder is
+    // created so the file shows up in listings; reads through the fs layer fetch pages
+    // on demand and keep them in an LRU page cache. The first write materializes the file.
+    int lazy_mount(const char* path, int64_t size);
+    int lazy_unmount(const char* path);
+
+    // Byte budget for resident lazy pages (default 16MB)
+    void set_lazy_budget(size_t bytes);
+    size_t lazy_resident_bytes();
+
+    // Content-addressed dedup. With a threshold set, truncating write_bytes calls of at
+    // least that many bytes store the contents as a shared blob keyed by XXH64: files
+    // with identical bytes share one copy, and copy_tree of such a file only adds a
+    // reference. Like lazy mounts, the file on disk is an empty placeholder, so read it
+    // through the fs layer rather than FS.readFile. 0 (the default) turns dedup off.
+    struct DedupStats {
+        uint64_t blobs;             // distinct contents stored
+        uint64_t references;        // files backed by a blob
+        uint64_t stored_bytes;      // bytes actually held
+        uint64_t logical_bytes;     // bytes the files would take as separate copies
+        uint64_t hits;              // writes and copies that reused an existing blob
+    };
+
+    void set_dedup_threshold(size_t min_bytes);
+    DedupStats dedup_stats();
+    // Store a file as a shared blob regardless of the threshold
+    int write_shared(const char* path, const uint8_t* data, size_t len);
+
+    // Block cache for regular file reads, keyed by path and 64KB block. Mutations through
+    // the fs layer invalidate it; writes made behind its back (e.g. FS.writeFile from JS)
+    // need invalidate_cached, where a null path clears everything. invalidate_cached
+    // also drops dentry cache entries for the path.
+    struct CacheStats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        size_t resident_bytes;
+        size_t budget;
+    };
+
+    CacheStats block_cache_stats();
+    // Byte budget for cached blocks (default 8MB); files over a quarter of it bypass the cache
+    void set_block_cache_budget(size_t bytes);
+    void invalidate_cached(const char* path);
+
+    // Flags for open_handle; values are shared with JS (see BIOSOpenFlags in bios.d.ts)
+    enum OpenFlags : int {
+        OPEN_READ = 1,
+        OPEN_WRITE = 2,
+        OPEN_CREATE = 4,
+        OPEN_TRUNCATE = 8,
+        OPEN_APPEND = 16
+    };
+
+    // Open file handles, held by integer id across calls (ids start at 1).
+    // The path is resolved once at open; reads and writes go straight to the descriptor.
+    // Writes are reported (caches dropped, change journaled) on a handle's first write and
+    // on close, so other readers of the file may see cached blocks until it is closed.
+    int open_handle(const char* path, int flags = OPEN_READ);
+    int64_t read_handle(int handle, uint8_t* buffer, size_t cap);
+    int64_t write_handle(int handle, const uint8_t* data, size_t len);
+    // whence follows SEEK_SET/SEEK_CUR/SEEK_END; returns the new offset or -1
+    int64_t seek_handle(int handle, int64_t offset, int whence);
+    int close_handle(int handle);
+
+    enum class EntryType : char {
+        Unknown,
+        File,
+        Directory,
+        Symlink,
+        Other
+    };
+
+    // Dentry cache (dentry.cpp): lstat metadata by absolute path, with negative entries,
+    // so repeated existence checks skip Emscripten's per-component path resolution.
+    // fs-layer mutations keep it current; changes made behind its back need
+    // invalidate_cached, like the block cache.
+    struct PathInfo {
+        EntryType type;
+        uint32_t mode;
+        int64_t size;       // logical size for lazy and blob files
+    };
+
+    struct DentryStats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t entries;
+    };
+
+    // 1 and info filled if path exists (symlinks are followed, like stat), 0 if it does not
+    int lookup_path(const char* path, PathInfo* info = nullptr);
+    DentryStats dentry_cache_stats();
+
+    struct DirEntry {
+        std::string_view name;
+        EntryType type;
+    };
+
+    typedef void (*EntryCallback)(const DirEntry& entry, void* context);
+
+    // Visit every entry of a directory. With resolve_types, the type comes from
+    // dirent::d_type where available and stat() is only called when it is unknown.
+    int for_each_entry(const char* path, EntryCallback callback, void* context, bool resolve_types = true);
+
+    // Shared newline-separated listing used by ls and list_directory;
+    // with_types prefixes each name with "d " or "- ". Works with any std::basic_string.
+    template <typename String>
+    int list_directory(const char* path, String& out, bool with_types) {
+        struct Context {
+            String& output;
+            bool with_types;
+        } context { out, with_types };
+
+        out.reserve(out.size() + 4096);
+        return for_each_entry(path, [](const DirEntry& entry, void* data) {
+            auto& list = *static_cast<Context*>(data);
+            if (list.with_types && entry.type != EntryType::Unknown) {
+                list.output.append(entry.type == EntryType::Directory ? "d " : "- ");
+            }
+            list.output.append(entry.name.data(), entry.name.size());
+            list.output.push_back('\n');
+        }, &context, with_types);
+    }
+
+    // path, relative and name are suffixes of one NUL-terminated buffer, so their
+    // data() can be passed straight to C APIs; they are only valid during the callback
+    struct WalkEntry {
+        std::string_view path;      // full path of the entry
+        std::string_view relative;  // path relative to the walk root
+        std::string_view name;
+        EntryType type;             // from d_type (lstat fallback); symlinks are not followed
+        int depth;                  // 0 for direct children of the root
+        bool post = false;          // second visit of a directory, after its contents
+    };
+
+    enum class WalkAction {
+        Continue,
+        Skip,   // do not descend into this directory
+        Stop
+    };
+
+    typedef WalkAction (*WalkCallback)(const WalkEntry& entry, void* context);
+
+    enum WalkFlags : int {
+        // Also visit each entered directory once more after its contents (post = true),
+        // as rm -r and du need; Skip is ignored on that visit
+        WALK_POST_ORDER = 1
+    };
+
+    // Iterative pre-order walk with an explicit stack of open directories.
+    // max_depth limits how many levels below the root are entered; negative is unlimited.
+    int walk(const char* root, int max_depth, WalkCallback callback, void* context, int flags = 0);
+
+    // Recursive tree operations on top of walk (tree.cpp). Symlinks are never followed,
+    // and every mutation goes through notify_changed. Return 0 on success, -1 if any
+    // entry failed; the rest of the tree is still processed.
+
+    // Remove a file, symlink or whole directory tree
+    int remove_tree(const char* path);
+    // Copy a file or symlink to dst, or a directory tree into a new or existing dst
+    int copy_tree(const char* src, const char* dst);
+    // Rename src to dst, falling back to copy and remove when rename() cannot
+    int move_path(const char* src, const char* dst);
+
+    // Change journal (journal.cpp): a bounded ring of fs-layer mutations, so callers can
+    // sync incrementally instead of rescanning. Write means path, or something below it,
+    // was created or modified; Remove means path and everything below it are gone (a
+    // rename is a Remove of the source and a Write of the destination). Values are
+    // shared with JS (see BIOSChangeOp in bios.d.ts).
+    enum class ChangeOp : uint8_t {
+        None = 0,       // invalidate caches only, e.g. materializing a lazy file
+        Write = 1,
+        Remove = 2
+    };
+
+    struct ChangeEvent {
+        uint32_t seq;
+        ChangeOp op;
+        std::string path;
+    };
+
+    // Append events newer than since to out, oldest first, and set last_seq to the newest
+    // seq. Returns false if events after since were already overwritten, or since is
+    // newer than any event (a seq saved before a reload), in which case the caller should
+    // rescan. Meant for a single reader; extra readers get repeated events, not gaps.
+    bool read_changes(uint32_t since, std::vector<ChangeEvent>& out, uint32_t& last_seq);
+
+    // Packed images of a directory tree (image.cpp): a header, a path-sorted entry table,
+    // a name table and an 8-byte aligned data section, all in one buffer that can be
+    // stored or transferred as-is.
+    // alloc is called once with the exact image size and returns the destination, or
+    // null to abort. Returns the image size, or -1 on failure.
+    typedef uint8_t* (*ImageAllocator)(size_t size, void* context);
+    int64_t snapshot_tree(const char* root, ImageAllocator alloc, void* context);
+    // Recreate an image's entries under root (created if missing) in one pass; files go
+    // through write_bytes, so dedup applies. Returns the number of entries, or -1 if the
+    // image is malformed or an entry cannot be written. Malformed images (bad offsets or
+    // types, unsorted or duplicate names, a parent that is not a directory entry) are
+    // rejected before anything is written.
+    int64_t restore_tree(const uint8_t* image, size_t len, const char* root);
+}
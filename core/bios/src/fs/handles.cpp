@@ -0,0 +1,143 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include "platform.hpp"
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace fs {
+    // Read-only handles keep their own position and read through the block cache (or
+    // the lazy page cache); the descriptor stays open so misses and fstat can use it.
+    // Writable handles use the descriptor offset directly, and report a change on their
+    // first write and again on close (so caches filled in between are dropped), not on
+    // every chunk.
+    struct Handle {
+        int fd;
+        int lazy;
+        bool positioned;
+        bool dirty;
+        int64_t position;
+        // Shared so that copying a slot out of the table does not allocate
+        std::shared_ptr<const std::string> path;
+    };
+
+    // Slot index + 1 is the handle id; a closed slot holds fd -1 and is reused.
+    // Guarded by handle_mutex since commands may run on pool workers.
+    static std::vector<Handle> handle_table;
+    static runtime::Mutex handle_mutex;
+
+    // Copy of the slot for a handle; fd is -1 if it is not open
+    static Handle lookup(int handle) {
+        runtime::LockGuard lock(handle_mutex);
+        if (handle <= 0 || static_cast<size_t>(handle) > handle_table.size()) return Handle { -1, -1, false, false, 0, nullptr };
+        return handle_table[handle - 1];
+    }
+
+    static void set_position(int handle, int64_t position) {
+        runtime::LockGuard lock(handle_mutex);
+        handle_table[handle - 1].position = position;
+    }
+
+    static int to_posix_flags(int flags) {
+        bool readable = flags & OPEN_READ;
+        bool writable = flags & (OPEN_WRITE | OPEN_APPEND);
+
+        int posix = readable && writable ? O_RDWR : writable ? O_WRONLY : O_RDONLY;
+        if (flags & OPEN_CREATE) posix |= O_CREAT;
+        if (flags & OPEN_TRUNCATE) posix |= O_TRUNC;
+        if (flags & OPEN_APPEND) posix |= O_APPEND;
+        return posix;
+    }
+
+    int open_handle(const char* path, int flags) {
+        if (!path || !(flags & (OPEN_READ | OPEN_WRITE | OPEN_APPEND))) return -1;
+
+        int lazy = lazy_id(path);
+        if (lazy >= 0 && (flags & (OPEN_WRITE | OPEN_APPEND))) {
+            if ((flags & OPEN_TRUNCATE) ? lazy_unmount(path) != 0 : lazy_materialize(path) != 0) return -1;
+            lazy = -1;
+        }
+
+        const bool writable = flags & (OPEN_WRITE | OPEN_APPEND);
+        int fd = open(path, to_posix_flags(flags), 0644);
+        if (fd < 0) return -1;
+        if (writable && (flags & (OPEN_CREATE | OPEN_TRUNCATE))) notify_changed(path);
+
+        Handle entry { fd, lazy, !writable, false, 0, std::make_shared<const std::string>(path) };
+        runtime::LockGuard lock(handle_mutex);
+        for (size_t i = 0; i < handle_table.size(); ++i) {
+            if (handle_table[i].fd < 0) {
+                handle_table[i] = entry;
+                return static_cast<int>(i + 1);
+            }
+        }
+
+        handle_table.push_back(entry);
+        return static_cast<int>(handle_table.size());
+    }
+
+    int64_t read_handle(int handle, uint8_t* buffer, size_t cap) {
+        Handle entry = lookup(handle);
+        if (entry.fd < 0 || (!buffer && cap > 0)) return -1;
+        if (!entry.positioned) return read_fully(entry.fd, buffer, cap);
+
+        int64_t n = entry.lazy >= 0
+            ? lazy_read(entry.lazy, entry.position, buffer, cap)
+            : cached_read(entry.path->c_str(), entry.fd, entry.position, buffer, cap);
+        if (n > 0) set_position(handle, entry.position + n);
+        return n;
+    }
+
+    int64_t write_handle(int handle, const uint8_t* data, size_t len) {
+        Handle entry = lookup(handle);
+        if (entry.fd < 0 || entry.positioned || (!data && len > 0)) return -1;
+
+        int status = write_fully(entry.fd, data, len);
+        if (!entry.dirty) {
+            {
+                runtime::LockGuard lock(handle_mutex);
+                handle_table[handle - 1].dirty = true;
+            }
+            notify_changed(entry.path->c_str());
+        }
+        return status == 0 ? static_cast<int64_t>(len) : -1;
+    }
+
+    int64_t seek_handle(int handle, int64_t offset, int whence) {
+        Handle entry = lookup(handle);
+        if (entry.fd < 0 || (whence != SEEK_SET && whence != SEEK_CUR && whence != SEEK_END)) return -1;
+
+        if (entry.positioned) {
+            int64_t end = -1;
+            if (whence == SEEK_END) {
+                struct stat st;
+                end = entry.lazy >= 0 ? lazy_size(entry.lazy) : fstat(entry.fd, &st) == 0 ? static_cast<int64_t>(st.st_size) : -1;
+            }
+            int64_t base = whence == SEEK_SET ? 0 : whence == SEEK_CUR ? entry.position : end;
+            if (base < 0 || base + offset < 0) return -1;
+            set_position(handle, base + offset);
+            return base + offset;
+        }
+
+        off_t position = lseek(entry.fd, static_cast<off_t>(offset), whence);
+        return position < 0 ? -1 : static_cast<int64_t>(position);
+    }
+
+    int close_handle(int handle) {
+        Handle entry;
+        {
+            runtime::LockGuard lock(handle_mutex);
+            if (handle <= 0 || static_cast<size_t>(handle) > handle_table.size()) return -1;
+            entry = handle_table[handle - 1];
+            if (entry.fd < 0) return -1;
+            handle_table[handle - 1] = Handle { -1, -1, false, false, 0, nullptr };
+        }
+
+        int status = close(entry.fd) == 0 ? 0 : -1;
+        if (entry.dirty) notify_changed(entry.path->c_str());
+        return status;
+    }
+}
@@ -0,0 +1,321 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace fs {
+    // Image layout, all fields little-endian uint32 so JS can read it with one Uint32Array:
+    //   header   ImageHeader (32 bytes)
+    //   entries  count ImageEntry records (24 bytes each), sorted by path
+    //   names    relative paths, each NUL-terminated (name_length excludes the NUL)
+    //   data     file contents and symlink targets, each starting on an 8-byte boundary
+    // Offsets in entries are relative to their section. Sorting by path puts every
+    // directory before its contents, so restore is a single forward pass.
+    constexpr uint32_t image_magic = 0x31534642;  // "BFS1"
+    constexpr uint32_t image_version = 1;
+
+    struct ImageHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t count;
+        uint32_t entry_size;
+        uint32_t names_offset;
+        uint32_t data_offset;
+        uint32_t image_size;
+        uint32_t reserved;
+    };
+
+    struct ImageEntry {
+        uint32_t name_offset;
+        uint32_t name_length;
+        uint8_t type;           // EntryType
+        uint8_t pad[3];
+        uint32_t mode;
+        uint32_t data_offset;
+        uint32_t size;
+    };
+
+    static_assert(sizeof(ImageHeader) == 32, "image header layout is shared with JS");
+    static_assert(sizeof(ImageEntry) == 24, "image entry layout is shared with JS");
+
+    static size_t align8(size_t value) {
+        return (value + 7) & ~static_cast<size_t>(7);
+    }
+
+    struct SnapshotItem {
+        std::string relative;
+        EntryType type;
+        uint32_t mode;
+        uint64_t size;
+    };
+
+    struct SnapshotContext {
+        std::vector<SnapshotItem> items;
+        bool whole_fs;
+        bool failed = false;
+    };
+
+    static WalkAction snapshot_entry(const WalkEntry& entry, void* data) {
+        auto& context = *static_cast<SnapshotContext*>(data);
+
+        // Device and proc trees are rebuilt by the runtime, not restored
+        if (context.whole_fs && entry.depth == 0 && (entry.name == "dev" || entry.name == "proc")) {
+            return WalkAction::Skip;
+        }
+
+        struct stat st;
+        if (lstat(entry.path.data(), &st) != 0) {
+            context.failed = true;
+            return WalkAction::Stop;
+        }
+
+        SnapshotItem item { std::string(entry.relative), EntryType::Other, static_cast<uint32_t>(st.st_mode & 07777), 0 };
+        if (S_ISDIR(st.st_mode)) {
+            item.type = EntryType::Directory;
+        } else if (S_ISREG(st.st_mode)) {
+            item.type = EntryType::File;
+            int64_t size = file_size(entry.path.data());  // logical size for lazy and blob files
+            item.size = size > 0 ? static_cast<uint64_t>(size) : 0;
+        } else if (S_ISLNK(st.st_mode)) {
+            item.type = EntryType::Symlink;
+            item.size = static_cast<uint64_t>(st.st_size);
+        } else {
+            return WalkAction::Continue;
+        }
+
+        context.items.push_back(std::move(item));
+        return WalkAction::Continue;
+    }
+
+    // Whole-file read for the snapshot pass; skips the block cache, which a one-off read
+    // of every file would only churn
+    static bool read_exact(const char* path, uint8_t* dest, size_t size) {
+        int id = lazy_id(path);
+        if (id >= 0) return lazy_read(id, 0, dest, size) == static_cast<int64_t>(size);
+
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return false;
+        int64_t n = read_fully(fd, dest, size);
+        close(fd);
+        return n == static_cast<int64_t>(size);
+    }
+
+    int64_t snapshot_tree(const char* root, ImageAllocator alloc, void* context) {
+        if (!root || !alloc) return -1;
+
+        struct stat st;
+        if (stat(root, &st) != 0 || !S_ISDIR(st.st_mode)) return -1;
+
+        SnapshotContext snapshot;
+        snapshot.whole_fs = root[0] == '/' && root[strspn(root, "/")] == '\0';
+        if (walk(root, -1, snapshot_entry, &snapshot) != 0 || snapshot.failed) return -1;
+
+        std::vector<SnapshotItem>& items = snapshot.items;
+        std::sort(items.begin(), items.end(),
+                  [](const SnapshotItem& a, const SnapshotItem& b) { return a.relative < b.relative; });
+
+        // Size everything first so the image is written once into its final buffer
+        size_t names_size = 0;
+        size_t data_size = 0;
+        for (const SnapshotItem& item : items) {
+            names_size += item.relative.size() + 1;
+            data_size = align8(data_size) + item.size;
+        }
+        const size_t names_offset = sizeof(ImageHeader) + items.size() * sizeof(ImageEntry);
+        const size_t data_offset = align8(names_offset + names_size);
+        const size_t image_size = data_offset + data_size;
+        if (image_size > UINT32_MAX) return -1;
+
+        uint8_t* image = alloc(image_size, context);
+        if (!image) return -1;
+        memset(image, 0, data_offset);
+
+        ImageHeader header { image_magic, image_version, static_cast<uint32_t>(items.size()),
+                             static_cast<uint32_t>(sizeof(ImageEntry)), static_cast<uint32_t>(names_offset),
+                             static_cast<uint32_t>(data_offset), static_cast<uint32_t>(image_size), 0 };
+        memcpy(image, &header, sizeof(header));
+
+        std::string path(root);
+        if (path.back() != '/') path += '/';
+        const size_t root_len = path.size();
+
+        size_t name_cursor = 0;
+        size_t data_cursor = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            const SnapshotItem& item = items[i];
+            const size_t padded = align8(data_cursor);
+            memset(image + data_offset + data_cursor, 0, padded - data_cursor);
+            data_cursor = padded;
+
+            ImageEntry entry {};
+            entry.name_offset = static_cast<uint32_t>(name_cursor);
+            entry.name_length = static_cast<uint32_t>(item.relative.size());
+            entry.type = static_cast<uint8_t>(item.type);
+            entry.mode = item.mode;
+            entry.data_offset = static_cast<uint32_t>(data_cursor);
+            entry.size = static_cast<uint32_t>(item.size);
+            memcpy(image + sizeof(ImageHeader) + i * sizeof(ImageEntry), &entry, sizeof(entry));
+
+            memcpy(image + names_offset + name_cursor, item.relative.c_str(), item.relative.size() + 1);
+            name_cursor += item.relative.size() + 1;
+
+            path.resize(root_len);
+            path += item.relative;
+            uint8_t* dest = image + data_offset + data_cursor;
+            if (item.type == EntryType::File) {
+                if (item.size && !read_exact(path.c_str(), dest, item.size)) return -1;
+            } else if (item.type == EntryType::Symlink) {
+                if (readlink(path.c_str(), reinterpret_cast<char*>(dest), item.size) != static_cast<ssize_t>(item.size)) return -1;
+            }
+            data_cursor += item.size;
+        }
+
+        return static_cast<int64_t>(image_size);
+    }
+
+    // Names come from untrusted images: relative, with no empty, "." or ".." components
+    // and no NULs
+    static bool safe_name(std::string_view name) {
+        if (name.empty() || name.find('\0') != std::string_view::npos) return false;
+        for (size_t start = 0; start <= name.size();) {
+            size_t end = name.find('/', start);
+            if (end == std::string_view::npos) end = name.size();
+            const std::string_view component = name.substr(start, end - start);
+            if (component.empty() || component == "." || component == "..") return false;
+            start = end + 1;
+        }
+        return true;
+    }
+
+    static int make_directories(std::string& path) {
+        for (size_t i = 1; i <= path.size(); ++i) {
+            if (i < path.size() && path[i] != '/') continue;
+            const char saved = path[i];
+            path[i] = '\0';
+            int status = mkdir(path.c_str(), 0755);
+            if (status == 0) notify_changed(path.c_str());
+            path[i] = saved;
+            if (status != 0 && errno != EEXIST) return -1;
+        }
+        return 0;
+    }
+
+    int64_t restore_tree(const uint8_t* image, size_t len, const char* root) {
+        if (!image || !root || !*root || len < sizeof(ImageHeader)) return -1;
+
+        ImageHeader header;
+        memcpy(&header, image, sizeof(header));
+        // Bound count before it is multiplied, so the entry table size cannot wrap
+        if (header.magic != image_magic || header.version != image_version ||
+            header.entry_size != sizeof(ImageEntry) || header.image_size > len ||
+            header.count > (len - sizeof(ImageHeader)) / sizeof(ImageEntry) ||
+            header.names_offset != sizeof(ImageHeader) + static_cast<size_t>(header.count) * sizeof(ImageEntry) ||
+            header.data_offset < header.names_offset || header.data_offset > header.image_size) {
+            return -1;
+        }
+
+        const char* names = reinterpret_cast<const char*>(image + header.names_offset);
+        const size_t names_size = header.data_offset - header.names_offset;
+        const uint8_t* data = image + header.data_offset;
+        const size_t data_size = header.image_size - header.data_offset;
+
+        // Validate every entry before touching the tree so a bad image leaves no partial
+        // restore. Names must be strictly increasing (sorted, no duplicates), and every
+        // parent must be a directory entry of the image. That also keeps entries from being
+        // written through a symlink the image itself creates.
+        auto entry_at = [image](uint32_t i) {
+            ImageEntry entry;
+            memcpy(&entry, image + sizeof(ImageHeader) + static_cast<size_t>(i) * sizeof(ImageEntry), sizeof(entry));
+            return entry;
+        };
+        std::vector<std::string_view> directories;   // sorted, since entries are
+        std::string_view previous;
+        for (uint32_t i = 0; i < header.count; ++i) {
+            const ImageEntry entry = entry_at(i);
+            if (entry.name_offset >= names_size || entry.name_length >= names_size - entry.name_offset ||
+                entry.data_offset > data_size || entry.size > data_size - entry.data_offset) {
+                return -1;
+            }
+
+            const std::string_view name(names + entry.name_offset, entry.name_length);
+            if (!safe_name(name) || (i > 0 && name <= previous)) return -1;
+            previous = name;
+
+            const size_t slash = name.rfind('/');
+            if (slash != std::string_view::npos &&
+                !std::binary_search(directories.begin(), directories.end(), name.substr(0, slash))) {
+                return -1;
+            }
+
+            switch (static_cast<EntryType>(entry.type)) {
+                case EntryType::Directory:
+                    directories.push_back(name);
+                    break;
+                case EntryType::File:
+                case EntryType::Symlink:
+                    break;
+                default:
+                    return -1;
+            }
+        }
+
+        std::string path(root);
+        while (path.size() > 1 && path.back() == '/') path.pop_back();
+        if (make_directories(path) != 0) return -1;
+        if (path.back() != '/') path += '/';
+        const size_t root_len = path.size();
+
+        int64_t restored = 0;
+        for (uint32_t i = 0; i < header.count; ++i) {
+            const ImageEntry entry = entry_at(i);
+            const std::string_view name(names + entry.name_offset, entry.name_length);
+            path.resize(root_len);
+            path.append(name.data(), name.size());
+            const uint8_t* bytes = data + entry.data_offset;
+            const mode_t mode = static_cast<mode_t>(entry.mode & 07777);
+
+            // The tree may already hold a symlink where the image has a file or directory;
+            // replace it rather than write through it
+            struct stat st;
+            const bool is_link = lstat(path.c_str(), &st) == 0 && S_ISLNK(st.st_mode);
+
+            int status = 0;
+            switch (static_cast<EntryType>(entry.type)) {
+                case EntryType::Directory:
+                    if (is_link) remove(path.c_str());
+                    if (mkdir(path.c_str(), mode) != 0 && (errno != EEXIST || stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))) {
+                        status = -1;
+                    }
+                    break;
+                case EntryType::File:
+                    if (is_link) remove(path.c_str());
+                    status = write_bytes(path.c_str(), bytes, entry.size);
+                    // WASI has no permission bits to restore
+#ifndef __wasi__
+                    if (status == 0 && mode != 0644) chmod(path.c_str(), mode);
+#endif
+                    break;
+                case EntryType::Symlink: {
+                    const std::string target(reinterpret_cast<const char*>(bytes), entry.size);
+                    if (remove(path.c_str()) == 0) lazy_unmount(path.c_str());
+                    status = symlink(target.c_str(), path.c_str()) == 0 ? 0 : -1;
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            if (status != 0) return -1;
+            ++restored;
+        }
+
+        notify_changed(root);
+        return restored;
+    }
+}
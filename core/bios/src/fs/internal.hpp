@@ -0,0 +1,66 @@
+#pragma once
+#include "fs.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fs {
+    // Fill buffer from fd until len bytes are read or EOF is hit.
+    // A non-negative offset reads positionally without moving the file offset.
+    int64_t read_fully(int fd, uint8_t* buffer, size_t len, int64_t offset = -1);
+
+    // Write all len bytes to fd, retrying short writes. Returns 0 on success, -1 on failure.
+    int write_fully(int fd, const uint8_t* data, size_t len);
+
+    // Called after any mutation of path so caches keyed by path drop their entries;
+    // entries below path are dropped too, so one call covers a renamed or removed directory.
+    // The change is also journaled as op.
+    void notify_changed(const char* path, ChangeOp op = ChangeOp::Write);
+
+    // Change journal (journal.cpp); repeats of the newest event are folded into it
+    // until a reader has received it
+    void journal_append(const char* path, ChangeOp op);
+
+    // Dentry cache (dentry.cpp): forget path and, for a directory, everything below it;
+    // null clears it. notify_changed and invalidate_cached call this.
+    void dentry_invalidate(const char* path);
+
+    // Block cache (cache.cpp). Reads through the cache, using fd for misses when it is
+    // open already (-1 opens path on demand). Returns bytes read or -1.
+    constexpr size_t cache_block_size = 64 * 1024;
+    int64_t cached_read(const char* path, int fd, int64_t offset, uint8_t* buffer, size_t len);
+
+    // Lazy backing (lazy.cpp). Pages are fetched and cached in units of lazy_page_size.
+    constexpr size_t lazy_page_size = 64 * 1024;
+
+    // Id of the lazy mount backing path, or -1 if the path is a regular file
+    int lazy_id(const char* path);
+    // Logical size of a lazy file, or -1 once it has been unmounted
+    int64_t lazy_size(int id);
+    int64_t lazy_read(int id, int64_t offset, uint8_t* buffer, size_t len);
+    // Copy the full contents into the placeholder file and drop the lazy backing
+    int lazy_materialize(const char* path);
+    // Re-key lazy mounts at from, or below it when it is a directory, after a rename
+    void lazy_rename(const char* from, const char* to);
+
+    // Content-addressed blobs (blobs.cpp). bytes never change once stored; refs is
+    // guarded by the blob store, which frees the blob when it drops to zero.
+    struct Blob {
+        uint64_t hash;
+        std::vector<uint8_t> bytes;
+        size_t refs;
+    };
+
+    // Reference the blob holding these bytes, storing them only if no blob matches
+    const Blob* blob_acquire(const uint8_t* data, size_t len);
+    void blob_retain(const Blob* blob);
+    void blob_release(const Blob* blob);
+    // Current write_bytes threshold from set_dedup_threshold (0 = off)
+    size_t dedup_min_bytes();
+
+    // Back path with a blob through the lazy registry, taking over one reference.
+    // Reads are served from the blob; writes materialize the file like any lazy mount.
+    int lazy_mount_blob(const char* path, const Blob* blob);
+    // Point dst at the blob behind src with a new reference; -1 if src is not blob-backed
+    int lazy_share(const char* src, const char* dst);
+}
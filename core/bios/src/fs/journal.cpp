@@ -0,0 +1,65 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include "platform.hpp"
+#include <vector>
+
+namespace fs {
+    // Bounded ring of recent changes; the oldest event is overwritten when it is full.
+    // Sequence numbers start at 1 and never repeat within a session.
+    constexpr size_t journal_capacity = 4096;
+
+    static runtime::Mutex journal_mutex;
+    static std::vector<ChangeEvent> journal;   // ring storage, grows to journal_capacity
+    static size_t journal_head = 0;            // slot of the next event once the ring is full
+    static uint32_t journal_seq = 0;           // seq of the newest event
+    // Newest seq read_changes has handed out, to any caller. The journal is meant for one
+    // reader; with several, each read also stops folding into events the others have not
+    // read yet, so they see more (repeated) events but never miss a change.
+    static uint32_t journal_read_seq = 0;
+
+    static const ChangeEvent* newest_event() {
+        if (journal.empty()) return nullptr;
+        return &journal[(journal_head + journal.size() - 1) % journal.size()];
+    }
+
+    void journal_append(const char* path, ChangeOp op) {
+        if (!path || op == ChangeOp::None) return;
+
+        runtime::LockGuard lock(journal_mutex);
+
+        // Streaming writes notify once per chunk; one event per run is enough. An event a
+        // reader has already received is final, so a repeat after it gets a new seq.
+        const ChangeEvent* last = newest_event();
+        if (last && last->seq > journal_read_seq && last->op == op && last->path == path) return;
+
+        ChangeEvent event { ++journal_seq, op, path };
+        if (journal.size() < journal_capacity) {
+            journal.push_back(std::move(event));
+        } else {
+            journal[journal_head] = std::move(event);
+            journal_head = (journal_head + 1) % journal_capacity;
+        }
+    }
+
+    bool read_changes(uint32_t since, std::vector<ChangeEvent>& out, uint32_t& last_seq) {
+        runtime::LockGuard lock(journal_mutex);
+        last_seq = journal_seq;
+        journal_read_seq = journal_seq;
+        if (since == journal_seq) return true;
+
+        // A since ahead of the journal comes from an earlier session (the module was
+        // reloaded and seqs restarted): nothing here can be trusted to follow it
+        if (since > journal_seq) return false;
+
+        // With n events retained, the oldest has seq journal_seq - n + 1
+        const uint32_t oldest = journal_seq - static_cast<uint32_t>(journal.size()) + 1;
+        const bool complete = since + 1 >= oldest;
+        const uint32_t first = complete ? since + 1 : oldest;
+
+        const size_t start = journal.size() < journal_capacity ? 0 : journal_head;
+        for (uint32_t seq = first; seq <= journal_seq; ++seq) {
+            out.push_back(journal[(start + (seq - oldest)) % journal.size()]);
+        }
+        return complete;
+    }
+}
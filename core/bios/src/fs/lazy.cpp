@@ -0,0 +1,257 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include "lru.hpp"
+#include "platform.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace fs {
+    struct LazyFile {
+        std::string path;
+        int64_t size;
+        const Blob* blob;   // in-heap contents instead of the page source, or null
+    };
+
+    // Page key: lazy file id in the high half, page index in the low half
+    static uint64_t page_key(int id, int64_t page) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(id)) << 32) | static_cast<uint32_t>(page);
+    }
+
+    static runtime::Mutex lazy_mutex;
+    static std::unordered_map<std::string, int> lazy_paths;
+    static std::unordered_map<int, LazyFile> lazy_files;
+    static LruCache<uint64_t, std::vector<uint8_t>> lazy_pages;
+    static PageSource page_source = nullptr;
+    static size_t lazy_budget = 16 * 1024 * 1024;
+    static size_t lazy_resident = 0;
+    static int next_lazy_id = 1;
+
+    // Evict least recently used pages until resident + incoming fits the budget
+    static void evict_for(size_t incoming) {
+        uint64_t key;
+        std::vector<uint8_t> page;
+        while (lazy_resident + incoming > lazy_budget && lazy_pages.evict(key, page)) {
+            lazy_resident -= page.size();
+        }
+    }
+
+    static void drop_pages(int id) {
+        const uint64_t prefix = page_key(id, 0);
+        lazy_pages.erase_if(
+            [prefix](uint64_t key, const std::vector<uint8_t>&) { return (key >> 32) == (prefix >> 32); },
+            [](uint64_t, const std::vector<uint8_t>& page) { lazy_resident -= page.size(); });
+    }
+
+    // Forget a mount: its cached pages and its blob reference go with it
+    static void drop_file(std::unordered_map<std::string, int>::iterator entry) {
+        auto file = lazy_files.find(entry->second);
+        if (file != lazy_files.end() && file->second.blob) {
+            // Blob reads never go through the page cache
+            blob_release(file->second.blob);
+        } else {
+            drop_pages(entry->second);
+        }
+        if (file != lazy_files.end()) lazy_files.erase(file);
+        lazy_paths.erase(entry);
+    }
+
+    // Create the empty placeholder and register path; replaces any existing mount
+    static int register_mount(const char* path, int64_t size, const Blob* blob) {
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return -1;
+        close(fd);
+        notify_changed(path);
+
+        runtime::LockGuard lock(lazy_mutex);
+        auto existing = lazy_paths.find(path);
+        if (existing != lazy_paths.end()) drop_file(existing);
+
+        int id = next_lazy_id++;
+        lazy_paths.emplace(path, id);
+        lazy_files.emplace(id, LazyFile { path, size, blob });
+        return 0;
+    }
+
+    void set_page_source(PageSource source) {
+        runtime::LockGuard lock(lazy_mutex);
+        page_source = source;
+    }
+
+    void set_lazy_budget(size_t bytes) {
+        runtime::LockGuard lock(lazy_mutex);
+        lazy_budget = bytes < lazy_page_size ? lazy_page_size : bytes;
+        evict_for(0);
+    }
+
+    size_t lazy_resident_bytes() {
+        runtime::LockGuard lock(lazy_mutex);
+        return lazy_resident;
+    }
+
+    int lazy_mount(const char* path, int64_t size) {
+        if (!path || size < 0) return -1;
+
+        // Empty placeholder so the file shows up in listings and stat-based checks
+        return register_mount(path, size, nullptr);
+    }
+
+    int lazy_mount_blob(const char* path, const Blob* blob) {
+        if (!path || !blob) return -1;
+        return register_mount(path, static_cast<int64_t>(blob->bytes.size()), blob);
+    }
+
+    int lazy_share(const char* src, const char* dst) {
+        if (!src || !dst) return -1;
+
+        const Blob* blob = nullptr;
+        {
+            runtime::LockGuard lock(lazy_mutex);
+            auto it = lazy_paths.find(src);
+            if (it == lazy_paths.end()) return -1;
+            blob = lazy_files[it->second].blob;
+            if (!blob) return -1;
+            // Retained under the lock so src cannot release it in between
+            blob_retain(blob);
+        }
+
+        if (register_mount(dst, static_cast<int64_t>(blob->bytes.size()), blob) != 0) {
+            blob_release(blob);
+            return -1;
+        }
+        return 0;
+    }
+
+    int lazy_unmount(const char* path) {
+        if (!path) return -1;
+
+        runtime::LockGuard lock(lazy_mutex);
+        auto it = lazy_paths.find(path);
+        if (it == lazy_paths.end()) return -1;
+
+        drop_file(it);
+        return 0;
+    }
+
+    int lazy_id(const char* path) {
+        if (!path) return -1;
+
+        runtime::LockGuard lock(lazy_mutex);
+        if (lazy_paths.empty()) return -1;
+        auto it = lazy_paths.find(path);
+        return it == lazy_paths.end() ? -1 : it->second;
+    }
+
+    int64_t lazy_size(int id) {
+        runtime::LockGuard lock(lazy_mutex);
+        auto it = lazy_files.find(id);
+        return it == lazy_files.end() ? -1 : it->second.size;
+    }
+
+    int64_t lazy_read(int id, int64_t offset, uint8_t* buffer, size_t len) {
+        if (offset < 0 || (!buffer && len > 0)) return -1;
+
+        runtime::UniqueLock lock(lazy_mutex);
+        auto file = lazy_files.find(id);
+        if (file == lazy_files.end()) return -1;
+
+        const int64_t size = file->second.size;
+        if (offset >= size) return 0;
+        if (static_cast<int64_t>(len) > size - offset) len = static_cast<size_t>(size - offset);
+
+        if (const Blob* blob = file->second.blob) {
+            memcpy(buffer, blob->bytes.data() + offset, len);
+            return static_cast<int64_t>(len);
+        }
+
+        const std::string path = file->second.path;
+
+        size_t copied = 0;
+        while (copied < len) {
+            int64_t position = offset + static_cast<int64_t>(copied);
+            int64_t page = position / static_cast<int64_t>(lazy_page_size);
+            size_t page_offset = static_cast<size_t>(position % static_cast<int64_t>(lazy_page_size));
+
+            std::vector<uint8_t>* data = lazy_pages.get(page_key(id, page));
+            if (!data) {
+                PageSource source = page_source;
+                if (!source) return copied ? static_cast<int64_t>(copied) : -1;
+
+                // The source may proxy to the main thread, so it runs without the lock held
+                int64_t page_start = page * static_cast<int64_t>(lazy_page_size);
+                size_t page_len = static_cast<size_t>(std::min<int64_t>(lazy_page_size, size - page_start));
+                std::vector<uint8_t> fetched(page_len);
+                lock.unlock();
+                int64_t n = source(path.c_str(), page_start, page_len, fetched.data());
+                lock.lock();
+                if (n < 0 || !lazy_files.count(id)) return copied ? static_cast<int64_t>(copied) : -1;
+                fetched.resize(static_cast<size_t>(std::min<int64_t>(n, page_len)));
+
+                data = lazy_pages.get(page_key(id, page));
+                if (!data) {
+                    evict_for(fetched.size());
+                    lazy_resident += fetched.size();
+                    data = &lazy_pages.put(page_key(id, page), std::move(fetched));
+                }
+            }
+
+            if (page_offset >= data->size()) break;  // backend returned a short page
+            size_t take = std::min(data->size() - page_offset, len - copied);
+            memcpy(buffer + copied, data->data() + page_offset, take);
+            copied += take;
+        }
+
+        return static_cast<int64_t>(copied);
+    }
+
+    int lazy_materialize(const char* path) {
+        int id = lazy_id(path);
+        if (id < 0) return -1;
+
+        int64_t size = lazy_size(id);
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return -1;
+
+        std::vector<uint8_t> chunk(lazy_page_size);
+        for (int64_t offset = 0; offset < size;) {
+            int64_t n = lazy_read(id, offset, chunk.data(), chunk.size());
+            if (n <= 0 || write_fully(fd, chunk.data(), static_cast<size_t>(n)) != 0) {
+                close(fd);
+                return -1;
+            }
+            offset += n;
+        }
+
+        close(fd);
+        notify_changed(path, ChangeOp::None);
+        return lazy_unmount(path);
+    }
+
+    void lazy_rename(const char* from, const char* to) {
+        if (!from || !to) return;
+
+        runtime::LockGuard lock(lazy_mutex);
+        if (lazy_paths.empty()) return;
+
+        const std::string_view prefix(from);
+        std::vector<std::pair<std::string, int>> moved;
+        for (auto it = lazy_paths.begin(); it != lazy_paths.end();) {
+            const std::string& path = it->first;
+            if (path.compare(0, prefix.size(), prefix) == 0 &&
+                (path.size() == prefix.size() || path[prefix.size()] == '/')) {
+                moved.emplace_back(to + path.substr(prefix.size()), it->second);
+                it = lazy_paths.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (auto& entry : moved) {
+            lazy_files[entry.second].path = entry.first;
+            lazy_paths[entry.first] = entry.second;
+        }
+    }
+}
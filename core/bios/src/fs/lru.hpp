@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace fs {
+    // Minimal LRU map: lookups move an entry to the front, eviction takes from the back.
+    // Callers track their own byte budgets and evict until they fit. Not thread-safe.
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class LruCache {
+    public:
+        Value* get(const Key& key) {
+            auto it = index.find(key);
+            if (it == index.end()) return nullptr;
+            order.splice(order.begin(), order, it->second);
+            return &it->second->second;
+        }
+
+        Value& put(const Key& key, Value value) {
+            auto it = index.find(key);
+            if (it != index.end()) {
+                it->second->second = std::move(value);
+                order.splice(order.begin(), order, it->second);
+                return it->second->second;
+            }
+            order.emplace_front(key, std::move(value));
+            index.emplace(key, order.begin());
+            return order.front().second;
+        }
+
+        // Remove the least recently used entry; returns false when empty
+        bool evict(Key& key, Value& value) {
+            if (order.empty()) return false;
+            key = std::move(order.back().first);
+            value = std::move(order.back().second);
+            index.erase(key);
+            order.pop_back();
+            return true;
+        }
+
+        bool erase(const Key& key) {
+            auto it = index.find(key);
+            if (it == index.end()) return false;
+            order.erase(it->second);
+            index.erase(it);
+            return true;
+        }
+
+        // Remove every entry for which predicate(key, value) is true; calls on_erase first
+        template <typename Predicate, typename OnErase>
+        void erase_if(Predicate predicate, OnErase on_erase) {
+            for (auto it = order.begin(); it != order.end();) {
+                if (predicate(it->first, it->second)) {
+                    on_erase(it->first, it->second);
+                    index.erase(it->first);
+                    it = order.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        size_t size() const { return order.size(); }
+
+        void clear() {
+            order.clear();
+            index.clear();
+        }
+
+    private:
+        typedef std::list<std::pair<Key, Value>> Order;
+        Order order;
+        std::unordered_map<Key, typename Order::iterator, Hash> index;
+    };
+}
@@ -0,0 +1,201 @@
+#include "fs.hpp"
+#include "internal.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace fs {
+    // Whole-tree operations notify the cache once for their root instead of per entry:
+    // notify_changed drops everything below a path, and per-file calls would scan the
+    // block cache once for every file in the tree
+
+    static bool is_inside(std::string_view path, std::string_view root) {
+        while (root.size() > 1 && root.back() == '/') root.remove_suffix(1);
+        return path.size() > root.size() && path.compare(0, root.size(), root) == 0 && path[root.size()] == '/';
+    }
+
+    struct RemoveContext {
+        int failures = 0;
+    };
+
+    static WalkAction remove_entry(const WalkEntry& entry, void* data) {
+        auto& context = *static_cast<RemoveContext*>(data);
+        const char* path = entry.path.data();
+
+        if (entry.type == EntryType::Directory) {
+            // Contents first; the directory itself goes on its post-order visit
+            if (entry.post && rmdir(path) != 0) ++context.failures;
+            return WalkAction::Continue;
+        }
+
+        if (remove(path) == 0) lazy_unmount(path);
+        else ++context.failures;
+        return WalkAction::Continue;
+    }
+
+    int remove_tree(const char* path) {
+        if (!path) return -1;
+
+        struct stat st;
+        if (lstat(path, &st) != 0) return -1;
+        if (!S_ISDIR(st.st_mode)) return remove_file(path);
+
+        RemoveContext context;
+        int status = walk(path, -1, remove_entry, &context, WALK_POST_ORDER);
+        if (status == 0 && rmdir(path) != 0) status = -1;
+        notify_changed(path, ChangeOp::Remove);
+
+        return status == 0 && context.failures == 0 ? 0 : -1;
+    }
+
+    // Copy one regular file; a blob-backed source only gains a reference, other lazy
+    // sources are read through their page cache
+    static int copy_file(const char* src, const char* dst, mode_t mode, std::vector<uint8_t>& buffer) {
+        if (lazy_share(src, dst) == 0) return 0;
+
+        int out = open(dst, O_WRONLY | O_CREAT | O_TRUNC, mode & 0777);
+        if (out < 0) return -1;
+        lazy_unmount(dst);
+
+        int status = 0;
+        int id = lazy_id(src);
+        if (id >= 0) {
+            int64_t n;
+            for (int64_t offset = 0; (n = lazy_read(id, offset, buffer.data(), buffer.size())) > 0; offset += n) {
+                if (write_fully(out, buffer.data(), static_cast<size_t>(n)) != 0) break;
+            }
+            if (n != 0) status = -1;
+        } else {
+            int in = open(src, O_RDONLY);
+            if (in < 0) {
+                close(out);
+                return -1;
+            }
+
+            int64_t n;
+            while ((n = read_fully(in, buffer.data(), buffer.size())) > 0) {
+                if (write_fully(out, buffer.data(), static_cast<size_t>(n)) != 0) break;
+            }
+            if (n != 0) status = -1;
+            close(in);
+        }
+
+        if (close(out) != 0) status = -1;
+        return status;
+    }
+
+    static int copy_symlink(const char* src, const char* dst) {
+        char target[4096];
+        ssize_t len = readlink(src, target, sizeof(target) - 1);
+        if (len < 0) return -1;
+        target[len] = '\0';
+
+        if (remove(dst) == 0) lazy_unmount(dst);
+        return symlink(target, dst) == 0 ? 0 : -1;
+    }
+
+    static int copy_directory(const char* dst, mode_t mode) {
+        if (mkdir(dst, mode & 0777) == 0) return 0;
+
+        struct stat st;
+        return errno == EEXIST && stat(dst, &st) == 0 && S_ISDIR(st.st_mode) ? 0 : -1;
+    }
+
+    struct CopyContext {
+        std::string target;     // destination root followed by '/'
+        size_t target_len;
+        std::vector<uint8_t> buffer;
+        int failures = 0;
+    };
+
+    static WalkAction copy_entry(const WalkEntry& entry, void* data) {
+        auto& context = *static_cast<CopyContext*>(data);
+        context.target.resize(context.target_len);
+        context.target.append(entry.relative.data(), entry.relative.size());
+
+        const char* src = entry.path.data();
+        const char* dst = context.target.c_str();
+
+        // lstat for the mode (and for types d_type could not answer)
+        struct stat st;
+        if (lstat(src, &st) != 0) {
+            ++context.failures;
+            return WalkAction::Skip;
+        }
+
+        int status;
+        if (S_ISDIR(st.st_mode)) {
+            status = copy_directory(dst, st.st_mode);
+            if (status != 0) {
+                ++context.failures;
+                return WalkAction::Skip;
+            }
+            return WalkAction::Continue;
+        } else if (S_ISREG(st.st_mode)) {
+            status = copy_file(src, dst, st.st_mode, context.buffer);
+        } else if (S_ISLNK(st.st_mode)) {
+            status = copy_symlink(src, dst);
+        } else {
+            status = -1;
+        }
+
+        if (status != 0) ++context.failures;
+        return WalkAction::Continue;
+    }
+
+    int copy_tree(const char* src, const char* dst) {
+        if (!src || !dst) return -1;
+
+        struct stat st;
+        if (lstat(src, &st) != 0) return -1;
+
+        struct stat existing;
+        if (stat(dst, &existing) == 0 && existing.st_dev == st.st_dev && existing.st_ino == st.st_ino) return -1;
+
+        int status;
+        if (S_ISREG(st.st_mode)) {
+            std::vector<uint8_t> buffer(cache_block_size);
+            status = copy_file(src, dst, st.st_mode, buffer);
+        } else if (S_ISLNK(st.st_mode)) {
+            status = copy_symlink(src, dst);
+        } else if (!S_ISDIR(st.st_mode) || is_inside(dst, src)) {
+            // Copying a directory into itself would walk its own output
+            return -1;
+        } else if (copy_directory(dst, st.st_mode) != 0) {
+            status = -1;
+        } else {
+            CopyContext context;
+            context.target = dst;
+            if (context.target.back() != '/') context.target += '/';
+            context.target_len = context.target.size();
+            context.buffer.resize(cache_block_size);
+
+            status = walk(src, -1, copy_entry, &context);
+            if (context.failures) status = -1;
+        }
+
+        notify_changed(dst);
+        return status;
+    }
+
+    int move_path(const char* src, const char* dst) {
+        if (!src || !dst) return -1;
+        if (is_inside(dst, src)) return -1;
+
+        if (rename(src, dst) == 0) {
+            lazy_unmount(dst);
+            lazy_rename(src, dst);
+            notify_changed(src, ChangeOp::Remove);
+            notify_changed(dst);
+            return 0;
+        }
+
+        // Only a move across mounts falls back to copying
+        if (errno != EXDEV) return -1;
+        if (copy_tree(src, dst) != 0) return -1;
+        return remove_tree(src);
+    }
+}
@@ -1,4 +1,8 @@
+import { createBindings } from './bindings.js'
+import { loadBIOS } from './loader.js'
+
 let bios
+let bindings
 export default bios
 
 export const consoleElement = document.getElementById('console')
@@ -12,15 +16,24 @@ function readStringFromWasm(ptr, length) {
     return textDecoder.decode(bios.HEAPU8.subarray(ptr, ptr + length))
 }
 
-function readBufferResult(ptr, lenPtr) {
-    const length = bios.HEAP32[lenPtr >> 2]
-    let result = ''
-    if (ptr) {
-        result = readStringFromWasm(ptr, length)
-        bios._free(ptr)
-    }
-    bios._free(lenPtr)
-    return result
+// Caller-owned read buffer, grown on demand and reused across reads
+let scratchPtr = 0
+let scratchSize = 0
+
+function ensureScratch(size) {
+    if (size <= scratchSize) return scratchPtr
+    if (scratchPtr) bios._free(scratchPtr)
+    scratchSize = Math.max(size, scratchSize * 2, 4096)
+    scratchPtr = bios._malloc(scratchSize)
+    return scratchPtr
+}
+
+// Decode a *_result export: header [length, status, capacity, reserved] then data
+function readResult(ptr) {
+    if (!ptr) return { status: -1, output: '' }
+    const length = bios.HEAP32[ptr >> 2]
+    const status = bios.HEAP32[(ptr >> 2) + 1]
+    return { status, output: readStringFromWasm(ptr + 16, length) }
 }
 
 export function log(message, type = 'info') {
@@ -38,13 +51,20 @@ export function log(message, type = 'info') {
 export async function initializeBIOS() {
     try {
         log('Initializing bios...')
-        const module = await import('/build/dist/bios.js')
-        globalThis.bios = bios = await module.default({
-            name: 'bios.wasm'
+        // ?variant=min loads the size-optimized build
+        const variant = new URLSearchParams(location.search).get('variant') === 'min' ? 'bios.min' : 'bios'
+        const module = await import(`/build/dist/${variant}.js`)
+        // No cacheKey: the dev build changes under the same URL, so the loader revalidates
+        // its cached .wasm against the server before each load
+        globalThis.bios = bios = await loadBIOS(module.default, {
+            name: `${variant}.wasm`,
+            wasmUrl: `/build/dist/${variant}.wasm`
         })
 
+        bindings = createBindings(bios)
+
         const state = bios._init()
-        const version = bios.ccall('get_version', 'string', [], [])
+        const version = bindings.getVersion()
 
         stateElement.textContent = ['BOOTING', 'RUNNING', 'PANIC'][state]
         versionElement.textContent = version
@@ -71,15 +91,8 @@ export async function executeCommand() {
     try {
         log(`> ${command}`)
 
-        const lenPtr = bios._malloc(4)
-        const ptr = bios.ccall(
-            'execute_with_output',
-            'number',
-            ['string', 'number'],
-            [command.trim(), lenPtr]
-        )
-        const output = readBufferResult(ptr, lenPtr)
-        const status = bios.ccall('get_last_status', 'number', [], [])
+        const ptr = bindings.executeResult(command.trim())
+        const { status, output } = readResult(ptr)
 
         if (output) log(output)
         if (!output && status !== 0) log(`Command failed with status ${status}`, 'error')
@@ -113,7 +126,7 @@ export async function writeFile() {
     if (!path || !content) return log('Please provide both path and content', 'error')
 
     try {
-        const result = bios.ccall('write_file', 'number', ['string', 'string'], [path, content])
+        const result = bindings.writeFile(path, content)
         if (result === 0) log(`File written successfully: ${path}`)
         else log(`Failed to write file: ${path}`, 'error')
     } catch (err) {
@@ -129,9 +142,12 @@ export async function readFile() {
     if (!path) return log('Please provide a file path', 'error')
 
     try {
-        const lenPtr = bios._malloc(4)
-        const ptr = bios.ccall('read_file', 'number', ['string', 'number'], [path, lenPtr])
-        const content = readBufferResult(ptr, lenPtr)
+        const size = bindings.fileSize(path)
+        if (size < 0) return log(`Failed to read file: ${path}`, 'error')
+
+        const ptr = ensureScratch(size)
+        const read = bindings.readFileInto(path, ptr, size)
+        const content = readStringFromWasm(ptr, read)
         if (content) {
             document.getElementById('file-content').value = content
             log(`File read successfully: ${path}`)
@@ -149,7 +165,7 @@ export async function deleteFile() {
     if (!path) return log('Please provide a file path', 'error')
 
     try {
-        const result = bios.ccall('delete_file', 'number', ['string'], [path])
+        const result = bindings.deleteFile(path)
         if (result === 0) {
             log(`File deleted successfully: ${path}`)
             document.getElementById('file-content').value = ''
@@ -167,7 +183,7 @@ export async function checkFileExists() {
     if (!path) return log('Please provide a file path', 'error')
 
     try {
-        const exists = bios.ccall('file_exists', 'number', ['string'], [path])
+        const exists = bindings.fileExists(path)
         log(`File ${path} ${exists ? 'exists' : 'does not exist'}`)
     } catch (err) {
         log(`File operation failed: ${err.message}`, 'error')
@@ -179,10 +195,9 @@ export async function listFiles() {
     if (!bios) return log('BIOS not initialized!', 'error')
 
     try {
-        const lenPtr = bios._malloc(4)
-        const ptr = bios.ccall('list_directory', 'number', ['string', 'number'], ['/', lenPtr])
-        const files = readBufferResult(ptr, lenPtr)
-        if (files) {
+        const ptr = bindings.listDirectoryResult('/')
+        const { status, output: files } = readResult(ptr)
+        if (status === 0) {
             log('Directory listing:')
             files.split('\n').forEach(file => {
                 if (file) log(`  ${file}`)
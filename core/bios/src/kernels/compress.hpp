@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Streaming compression for the gzip/lz4 commands and the codec exports.
+// gzip goes through zlib (emscripten's USE_ZLIB port); LZ4 is implemented here.
+namespace kernels {
+    // Values are shared with JS (see BIOSCodec in bios.d.ts)
+    enum class Codec : int {
+        Gzip = 0,
+        Lz4 = 1
+    };
+
+    typedef void (*ChunkCallback)(const uint8_t* data, size_t len, void* context);
+
+    // One direction of one codec. Output is handed to the callback as it is produced;
+    // chunks are only valid during the call. update/finish return 0, or -1 on bad input.
+    class CodecStream {
+    public:
+        virtual ~CodecStream() = default;
+        virtual int update(const uint8_t* data, size_t len, ChunkCallback callback, void* context) = 0;
+        virtual int finish(ChunkCallback callback, void* context) = 0;
+    };
+
+    // level is 1-9 (0 picks zlib's default); the gzip decoder also takes zlib streams
+    // and concatenated members
+    std::unique_ptr<CodecStream> make_gzip_compressor(int level = 0);
+    std::unique_ptr<CodecStream> make_gzip_decompressor();
+
+    // LZ4 frame format; the decoder handles linked blocks, checksums and skippable frames
+    std::unique_ptr<CodecStream> make_lz4_compressor();
+    std::unique_ptr<CodecStream> make_lz4_decompressor();
+
+    inline std::unique_ptr<CodecStream> make_compressor(Codec codec, int level = 0) {
+        return codec == Codec::Gzip ? make_gzip_compressor(level) : make_lz4_compressor();
+    }
+
+    inline std::unique_ptr<CodecStream> make_decompressor(Codec codec) {
+        return codec == Codec::Gzip ? make_gzip_decompressor() : make_lz4_decompressor();
+    }
+
+    // Raw LZ4 block format. dst must hold lz4_bound(len) bytes; returns the compressed size.
+    size_t lz4_bound(size_t len);
+    size_t lz4_compress_block(const uint8_t* src, size_t len, uint8_t* dst);
+
+    // Decode a block into dst + prefix; the prefix bytes already in dst serve as the
+    // match history for linked blocks. Returns the decoded size, or -1 on corrupt input.
+    int64_t lz4_decompress_block(const uint8_t* src, size_t len, uint8_t* dst, size_t cap, size_t prefix = 0);
+}
@@ -0,0 +1,207 @@
+#include "kernels.hpp"
+#include <array>
+#include <cstring>
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+namespace kernels {
+    static constexpr char base64_standard[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static constexpr char base64_url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    // Decoded value of each byte, accepting both alphabets; 0xFF marks invalid input
+    static constexpr std::array<uint8_t, 256> make_base64_table() {
+        std::array<uint8_t, 256> table {};
+        for (auto& value : table) value = 0xFF;
+        for (uint8_t i = 0; i < 64; ++i) {
+            table[static_cast<uint8_t>(base64_standard[i])] = i;
+            table[static_cast<uint8_t>(base64_url[i])] = i;
+        }
+        return table;
+    }
+
+    static constexpr std::array<uint8_t, 256> base64_table = make_base64_table();
+
+    size_t base64_encoded_size(size_t len, bool url) {
+        return url ? (len * 4 + 2) / 3 : (len + 2) / 3 * 4;
+    }
+
+    size_t base64_decoded_size(const char* data, size_t len) {
+        for (int padding = 0; padding < 2 && len > 0 && data[len - 1] == '='; ++padding) --len;
+        return len / 4 * 3 + (len % 4 > 1 ? len % 4 - 1 : 0);
+    }
+
+    size_t base64_encode(const uint8_t* data, size_t len, char* out, bool url) {
+        const char* alphabet = url ? base64_url : base64_standard;
+        char* start = out;
+
+        size_t i = 0;
+        for (; i + 3 <= len; i += 3) {
+            uint32_t v = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+            out[0] = alphabet[v >> 18];
+            out[1] = alphabet[(v >> 12) & 63];
+            out[2] = alphabet[(v >> 6) & 63];
+            out[3] = alphabet[v & 63];
+            out += 4;
+        }
+
+        const size_t rest = len - i;
+        if (rest) {
+            uint32_t v = uint32_t(data[i]) << 16;
+            if (rest == 2) v |= uint32_t(data[i + 1]) << 8;
+            *out++ = alphabet[v >> 18];
+            *out++ = alphabet[(v >> 12) & 63];
+            if (rest == 2) *out++ = alphabet[(v >> 6) & 63];
+            if (!url) {
+                if (rest == 1) *out++ = '=';
+                *out++ = '=';
+            }
+        }
+        return static_cast<size_t>(out - start);
+    }
+
+    int64_t base64_decode(const char* data, size_t len, uint8_t* out) {
+        const auto* in = reinterpret_cast<const uint8_t*>(data);
+
+        // Padding is optional, but if present it must finish a 4-character group
+        size_t padding = 0;
+        while (len > 0 && padding < 2 && in[len - 1] == '=') {
+            --len;
+            ++padding;
+        }
+        if (padding && (len + padding) % 4 != 0) return -1;
+        if (len % 4 == 1) return -1;
+
+        uint8_t* start = out;
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            uint32_t a = base64_table[in[i]], b = base64_table[in[i + 1]];
+            uint32_t c = base64_table[in[i + 2]], d = base64_table[in[i + 3]];
+            if ((a | b | c | d) & 0x80) return -1;
+            uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+            out[0] = static_cast<uint8_t>(v >> 16);
+            out[1] = static_cast<uint8_t>(v >> 8);
+            out[2] = static_cast<uint8_t>(v);
+            out += 3;
+        }
+
+        const size_t rest = len - i;
+        if (rest) {
+            uint32_t a = base64_table[in[i]], b = base64_table[in[i + 1]];
+            uint32_t c = rest == 3 ? base64_table[in[i + 2]] : 0;
+            if ((a | b | c) & 0x80) return -1;
+            uint32_t v = (a << 18) | (b << 12) | (c << 6);
+            *out++ = static_cast<uint8_t>(v >> 16);
+            if (rest == 3) *out++ = static_cast<uint8_t>(v >> 8);
+        }
+        return static_cast<int64_t>(out - start);
+    }
+
+    static constexpr char hex_digits[] = "0123456789abcdef";
+
+    void hex_encode(const uint8_t* data, size_t len, char* out) {
+        size_t i = 0;
+#ifdef __wasm_simd128__
+        // Split each byte into nibbles, map them through a 16-entry table with one
+        // swizzle, then interleave high and low digits
+        const v128_t digits = wasm_v128_load(hex_digits);
+        const v128_t low_mask = wasm_i8x16_splat(0x0F);
+        for (; i + 16 <= len; i += 16) {
+            v128_t bytes = wasm_v128_load(data + i);
+            v128_t high = wasm_i8x16_swizzle(digits, wasm_u8x16_shr(bytes, 4));
+            v128_t low = wasm_i8x16_swizzle(digits, wasm_v128_and(bytes, low_mask));
+            wasm_v128_store(out + i * 2, wasm_i8x16_shuffle(high, low, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23));
+            wasm_v128_store(out + i * 2 + 16, wasm_i8x16_shuffle(high, low, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+        }
+#endif
+        for (; i < len; ++i) {
+            out[i * 2] = hex_digits[data[i] >> 4];
+            out[i * 2 + 1] = hex_digits[data[i] & 15];
+        }
+    }
+
+    static inline int hex_value(uint8_t c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        c |= 0x20;  // fold to lower case
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    int64_t hex_decode(const char* data, size_t len, uint8_t* out) {
+        if (len % 2) return -1;
+        const auto* in = reinterpret_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; i += 2) {
+            int high = hex_value(in[i]);
+            int low = hex_value(in[i + 1]);
+            if ((high | low) < 0) return -1;
+            out[i / 2] = static_cast<uint8_t>((high << 4) | low);
+        }
+        return static_cast<int64_t>(len / 2);
+    }
+
+    size_t utf8_validate(const uint8_t* data, size_t len) {
+        size_t i = 0;
+        while (i < len) {
+#ifdef __wasm_simd128__
+            // ASCII fast path: skip 16 bytes at a time while no byte has its top bit set
+            while (i + 16 <= len && !wasm_i8x16_bitmask(wasm_v128_load(data + i))) i += 16;
+            if (i >= len) break;
+#endif
+            const uint8_t c = data[i];
+            if (c < 0x80) {
+                ++i;
+                continue;
+            }
+
+            // Lead byte gives the length and the valid range of the first continuation
+            // byte, which rules out overlong forms, surrogates and code points past U+10FFFF
+            size_t need;
+            uint8_t low = 0x80, high = 0xBF;
+            if (c >= 0xC2 && c <= 0xDF) {
+                need = 1;
+            } else if (c >= 0xE0 && c <= 0xEF) {
+                need = 2;
+                if (c == 0xE0) low = 0xA0;
+                if (c == 0xED) high = 0x9F;
+            } else if (c >= 0xF0 && c <= 0xF4) {
+                need = 3;
+                if (c == 0xF0) low = 0x90;
+                if (c == 0xF4) high = 0x8F;
+            } else {
+                return i;
+            }
+
+            if (len - i <= need) return i;
+            if (data[i + 1] < low || data[i + 1] > high) return i;
+            for (size_t k = 2; k <= need; ++k) {
+                if ((data[i + k] & 0xC0) != 0x80) return i;
+            }
+            i += need + 1;
+        }
+        return len;
+    }
+
+    void byte_swap(uint8_t* data, size_t len, size_t width) {
+        if (width != 2 && width != 4 && width != 8) return;
+        len -= len % width;
+
+        size_t i = 0;
+#ifdef __wasm_simd128__
+        v128_t order;
+        if (width == 2) order = wasm_i8x16_make(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        else if (width == 4) order = wasm_i8x16_make(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        else order = wasm_i8x16_make(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        for (; i + 16 <= len; i += 16) {
+            wasm_v128_store(data + i, wasm_i8x16_swizzle(wasm_v128_load(data + i), order));
+        }
+#endif
+        for (; i < len; i += width) {
+            for (size_t a = i, b = i + width - 1; a < b; ++a, --b) {
+                const uint8_t t = data[a];
+                data[a] = data[b];
+                data[b] = t;
+            }
+        }
+    }
+}
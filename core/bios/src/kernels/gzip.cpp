@@ -0,0 +1,107 @@
+#include "compress.hpp"
+#include <vector>
+#include <zlib.h>
+
+namespace kernels {
+    static constexpr size_t zlib_chunk_size = 64 * 1024;
+
+    // gzip container (windowBits 15 + 16) via deflate
+    class GzipCompressor : public CodecStream {
+    public:
+        explicit GzipCompressor(int level) : out(zlib_chunk_size) {
+            stream = z_stream();
+            ready = deflateInit2(&stream, level > 0 && level <= 9 ? level : Z_DEFAULT_COMPRESSION,
+                Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        }
+
+        ~GzipCompressor() override {
+            if (ready) deflateEnd(&stream);
+        }
+
+        int update(const uint8_t* data, size_t len, ChunkCallback callback, void* context) override {
+            return run(data, len, Z_NO_FLUSH, callback, context);
+        }
+
+        int finish(ChunkCallback callback, void* context) override {
+            return run(nullptr, 0, Z_FINISH, callback, context);
+        }
+
+    private:
+        int run(const uint8_t* data, size_t len, int flush, ChunkCallback callback, void* context) {
+            if (!ready) return -1;
+
+            stream.next_in = const_cast<Bytef*>(data);
+            stream.avail_in = static_cast<uInt>(len);
+            int status;
+            do {
+                stream.next_out = out.data();
+                stream.avail_out = static_cast<uInt>(out.size());
+                status = deflate(&stream, flush);
+                if (status == Z_STREAM_ERROR) return -1;
+
+                size_t produced = out.size() - stream.avail_out;
+                if (produced) callback(out.data(), produced, context);
+            } while (stream.avail_out == 0 || (flush == Z_FINISH && status != Z_STREAM_END));
+            return 0;
+        }
+
+        z_stream stream;
+        std::vector<uint8_t> out;
+        bool ready;
+    };
+
+    // Accepts gzip or zlib input (windowBits 15 + 32), including concatenated gzip members
+    class GzipDecompressor : public CodecStream {
+    public:
+        GzipDecompressor() : out(zlib_chunk_size) {
+            stream = z_stream();
+            ready = inflateInit2(&stream, 15 + 32) == Z_OK;
+        }
+
+        ~GzipDecompressor() override {
+            if (ready) inflateEnd(&stream);
+        }
+
+        int update(const uint8_t* data, size_t len, ChunkCallback callback, void* context) override {
+            if (!ready) return -1;
+
+            stream.next_in = const_cast<Bytef*>(data);
+            stream.avail_in = static_cast<uInt>(len);
+            while (stream.avail_in > 0) {
+                if (ended) {
+                    if (inflateReset(&stream) != Z_OK) return -1;
+                    ended = false;
+                }
+
+                stream.next_out = out.data();
+                stream.avail_out = static_cast<uInt>(out.size());
+                int status = inflate(&stream, Z_NO_FLUSH);
+                if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) return -1;
+
+                size_t produced = out.size() - stream.avail_out;
+                if (produced) callback(out.data(), produced, context);
+                if (status == Z_STREAM_END) ended = true;
+                else if (status == Z_BUF_ERROR && produced == 0) return -1;
+            }
+            return 0;
+        }
+
+        int finish(ChunkCallback, void*) override {
+            return ready && ended ? 0 : -1;
+        }
+
+    private:
+        z_stream stream;
+        std::vector<uint8_t> out;
+        bool ready;
+        bool ended = false;
+    };
+
+    std::unique_ptr<CodecStream> make_gzip_compressor(int level) {
+        return std::unique_ptr<CodecStream>(new GzipCompressor(level));
+    }
+
+    std::unique_ptr<CodecStream> make_gzip_decompressor() {
+        return std::unique_ptr<CodecStream>(new GzipDecompressor());
+    }
+}
@@ -0,0 +1,201 @@
+#include "kernels.hpp"
+#include <array>
+#include <cstring>
+
+namespace kernels {
+    static constexpr uint32_t sha256_k[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    static inline uint32_t rotr(uint32_t x, int n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    Sha256::Sha256()
+        : state { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 } {}
+
+    void Sha256::compress(const uint8_t block[64]) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+                   (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+
+    void Sha256::update(const uint8_t* data, size_t len) {
+        total += len;
+        if (buffered) {
+            size_t take = len < 64 - buffered ? len : 64 - buffered;
+            memcpy(buffer + buffered, data, take);
+            buffered += take;
+            data += take;
+            len -= take;
+            if (buffered < 64) return;
+            compress(buffer);
+            buffered = 0;
+        }
+        for (; len >= 64; data += 64, len -= 64) compress(data);
+        memcpy(buffer, data, len);
+        buffered = len;
+    }
+
+    void Sha256::finish(uint8_t digest[32]) {
+        const uint64_t bits = total * 8;
+        buffer[buffered++] = 0x80;
+        if (buffered > 56) {
+            memset(buffer + buffered, 0, 64 - buffered);
+            compress(buffer);
+            buffered = 0;
+        }
+        memset(buffer + buffered, 0, 56 - buffered);
+        for (int i = 0; i < 8; ++i) buffer[56 + i] = static_cast<uint8_t>(bits >> (56 - i * 8));
+        compress(buffer);
+
+        for (int i = 0; i < 8; ++i) {
+            digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+            digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+            digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+            digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+        }
+    }
+
+    // Slicing-by-8 tables for the reflected polynomial 0xEDB88320
+    typedef std::array<std::array<uint32_t, 256>, 8> Crc32Tables;
+
+    static constexpr Crc32Tables make_crc32_tables() {
+        Crc32Tables tables {};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+            tables[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (size_t t = 1; t < 8; ++t) {
+                uint32_t prev = tables[t - 1][i];
+                tables[t][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+            }
+        }
+        return tables;
+    }
+
+    static constexpr Crc32Tables crc32_tables = make_crc32_tables();
+
+    uint32_t crc32(uint32_t crc, const uint8_t* data, size_t len) {
+        crc = ~crc;
+        for (; len >= 8; data += 8, len -= 8) {
+            uint32_t lo = crc ^ (uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24));
+            uint32_t hi = uint32_t(data[4]) | (uint32_t(data[5]) << 8) | (uint32_t(data[6]) << 16) | (uint32_t(data[7]) << 24);
+            crc = crc32_tables[7][lo & 0xFF] ^ crc32_tables[6][(lo >> 8) & 0xFF] ^
+                  crc32_tables[5][(lo >> 16) & 0xFF] ^ crc32_tables[4][lo >> 24] ^
+                  crc32_tables[3][hi & 0xFF] ^ crc32_tables[2][(hi >> 8) & 0xFF] ^
+                  crc32_tables[1][(hi >> 16) & 0xFF] ^ crc32_tables[0][hi >> 24];
+        }
+        while (len--) crc = (crc >> 8) ^ crc32_tables[0][(crc ^ *data++) & 0xFF];
+        return ~crc;
+    }
+
+    static constexpr uint64_t xxh_prime1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t xxh_prime2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t xxh_prime3 = 0x165667B19E3779F9ull;
+    static constexpr uint64_t xxh_prime4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr uint64_t xxh_prime5 = 0x27D4EB2F165667C5ull;
+
+    static inline uint64_t rotl64(uint64_t x, int n) {
+        return (x << n) | (x >> (64 - n));
+    }
+
+    static inline uint64_t load64(const uint8_t* p) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        return v;  // wasm and x86 are little-endian, as XXH64 expects
+    }
+
+    static inline uint32_t load32(const uint8_t* p) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        return v;
+    }
+
+    static inline uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+        return rotl64(acc + input * xxh_prime2, 31) * xxh_prime1;
+    }
+
+    static inline uint64_t xxh64_merge(uint64_t acc, uint64_t value) {
+        return (acc ^ xxh64_round(0, value)) * xxh_prime1 + xxh_prime4;
+    }
+
+    uint64_t xxh64(const uint8_t* data, size_t len, uint64_t seed) {
+        const uint8_t* end = data + len;
+        uint64_t h;
+
+        if (len >= 32) {
+            // Four independent lanes over 32-byte stripes
+            uint64_t v1 = seed + xxh_prime1 + xxh_prime2;
+            uint64_t v2 = seed + xxh_prime2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - xxh_prime1;
+            const uint8_t* limit = end - 32;
+            do {
+                v1 = xxh64_round(v1, load64(data));
+                v2 = xxh64_round(v2, load64(data + 8));
+                v3 = xxh64_round(v3, load64(data + 16));
+                v4 = xxh64_round(v4, load64(data + 24));
+                data += 32;
+            } while (data <= limit);
+
+            h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+            h = xxh64_merge(h, v1);
+            h = xxh64_merge(h, v2);
+            h = xxh64_merge(h, v3);
+            h = xxh64_merge(h, v4);
+        } else {
+            h = seed + xxh_prime5;
+        }
+
+        h += static_cast<uint64_t>(len);
+        for (; data + 8 <= end; data += 8) {
+            h ^= xxh64_round(0, load64(data));
+            h = rotl64(h, 27) * xxh_prime1 + xxh_prime4;
+        }
+        if (data + 4 <= end) {
+            h ^= static_cast<uint64_t>(load32(data)) * xxh_prime1;
+            h = rotl64(h, 23) * xxh_prime2 + xxh_prime3;
+            data += 4;
+        }
+        for (; data < end; ++data) {
+            h ^= (*data) * xxh_prime5;
+            h = rotl64(h, 11) * xxh_prime1;
+        }
+
+        h ^= h >> 33;
+        h *= xxh_prime2;
+        h ^= h >> 29;
+        h *= xxh_prime3;
+        h ^= h >> 32;
+        return h;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Byte-crunching kernels shared by the commands and exports.
+// Each kernel has a wasm SIMD128 path (built with -msimd128) and a scalar fallback.
+namespace kernels {
+    // First occurrence of byte in data, or nullptr
+    const uint8_t* find_byte(const uint8_t* data, size_t len, uint8_t byte);
+
+    // First occurrence of needle in data, or nullptr; an empty needle matches at data
+    const uint8_t* find_bytes(const uint8_t* data, size_t len, const uint8_t* needle, size_t needle_len);
+
+    // Number of occurrences of byte in data
+    size_t count_byte(const uint8_t* data, size_t len, uint8_t byte);
+
+    // Streaming line/word/byte counter (words are runs of non-whitespace, as in wc)
+    class TextCounter {
+    public:
+        void update(const uint8_t* data, size_t len);
+
+        uint64_t lines = 0;
+        uint64_t words = 0;
+        uint64_t bytes = 0;
+
+    private:
+        bool in_space = true;
+    };
+
+    // Streaming SHA-256
+    class Sha256 {
+    public:
+        Sha256();
+        void update(const uint8_t* data, size_t len);
+        void finish(uint8_t digest[32]);
+
+    private:
+        void compress(const uint8_t block[64]);
+
+        uint32_t state[8];
+        uint8_t buffer[64];
+        size_t buffered = 0;
+        uint64_t total = 0;
+    };
+
+    // CRC-32 (IEEE 802.3, as used by zlib/gzip); pass the previous result to continue a stream
+    uint32_t crc32(uint32_t crc, const uint8_t* data, size_t len);
+
+    // XXH64 (xxHash, 64-bit): fast non-cryptographic hash for content addressing
+    uint64_t xxh64(const uint8_t* data, size_t len, uint64_t seed = 0);
+
+    // Base64 (RFC 4648). url selects the -_ alphabet without padding. Encoding writes
+    // exactly base64_encoded_size bytes; decoding accepts either alphabet with optional
+    // padding, writes at most base64_decoded_size bytes, and returns the size or -1 if invalid.
+    size_t base64_encoded_size(size_t len, bool url = false);
+    size_t base64_decoded_size(const char* data, size_t len);
+    size_t base64_encode(const uint8_t* data, size_t len, char* out, bool url = false);
+    int64_t base64_decode(const char* data, size_t len, uint8_t* out);
+
+    // Lower-case hex; out holds 2 * len chars. Decoding takes either case and returns
+    // len / 2, or -1 for odd lengths and non-hex digits.
+    void hex_encode(const uint8_t* data, size_t len, char* out);
+    int64_t hex_decode(const char* data, size_t len, uint8_t* out);
+
+    // Offset of the first byte that starts an invalid or truncated UTF-8 sequence, or
+    // len when all of data is valid (overlongs, surrogates and > U+10FFFF are invalid)
+    size_t utf8_validate(const uint8_t* data, size_t len);
+
+    // Reverse the byte order of each width-byte unit (2, 4 or 8) in place; a trailing
+    // partial unit is left alone
+    void byte_swap(uint8_t* data, size_t len, size_t width);
+}
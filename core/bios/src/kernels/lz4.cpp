@@ -0,0 +1,384 @@
+#include "compress.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace kernels {
+    // LZ4 frame format (lz4_Frame_format.md): independent 64KB blocks, no checksums.
+    // The decoder also accepts linked blocks, checksums, content size and larger blocks.
+    static constexpr uint32_t frame_magic = 0x184D2204;
+    static constexpr size_t frame_block_size = 64 * 1024;
+    static constexpr size_t max_block_size = 4 * 1024 * 1024;
+    static constexpr size_t history_size = 64 * 1024;
+
+    static constexpr size_t min_match = 4;
+    static constexpr size_t last_literals = 5;   // a block always ends with 5+ literals
+    static constexpr size_t match_limit = 12;    // no match may start in the last 12 bytes
+    static constexpr int hash_bits = 12;
+
+    static uint32_t load32(const uint8_t* p) {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint32_t load_le32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+            static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+    }
+
+    static void store_le32(uint8_t* p, uint32_t value) {
+        p[0] = static_cast<uint8_t>(value);
+        p[1] = static_cast<uint8_t>(value >> 8);
+        p[2] = static_cast<uint8_t>(value >> 16);
+        p[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    static uint32_t hash4(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - hash_bits);
+    }
+
+    // Length fields past the 4-bit token nibble: runs of 255 then the remainder
+    static uint8_t* write_length(uint8_t* op, size_t len) {
+        for (; len >= 255; len -= 255) *op++ = 255;
+        *op++ = static_cast<uint8_t>(len);
+        return op;
+    }
+
+    static uint8_t* write_sequence(uint8_t* op, const uint8_t* literals, size_t literal_len, size_t offset, size_t match_len) {
+        uint8_t* token = op++;
+        size_t extra_match = match_len - min_match;
+        *token = static_cast<uint8_t>((std::min<size_t>(literal_len, 15) << 4) | std::min<size_t>(extra_match, 15));
+
+        if (literal_len >= 15) op = write_length(op, literal_len - 15);
+        memcpy(op, literals, literal_len);
+        op += literal_len;
+
+        *op++ = static_cast<uint8_t>(offset);
+        *op++ = static_cast<uint8_t>(offset >> 8);
+        if (extra_match >= 15) op = write_length(op, extra_match - 15);
+        return op;
+    }
+
+    size_t lz4_bound(size_t len) {
+        return len + len / 255 + 16;
+    }
+
+    size_t lz4_compress_block(const uint8_t* src, size_t len, uint8_t* dst) {
+        uint8_t* op = dst;
+        size_t anchor = 0;
+
+        if (len > match_limit) {
+            // Positions are stored + 1 so 0 means empty
+            std::vector<uint32_t> table(size_t(1) << hash_bits, 0);
+            const size_t ip_limit = len - match_limit;
+            const size_t match_end = len - last_literals;
+
+            size_t ip = 0;
+            while (ip <= ip_limit) {
+                const uint32_t sequence = load32(src + ip);
+                const uint32_t h = hash4(sequence);
+                const uint32_t candidate = table[h];
+                table[h] = static_cast<uint32_t>(ip + 1);
+
+                if (!candidate || ip - (candidate - 1) > 65535 || load32(src + candidate - 1) != sequence) {
+                    // Skip faster through incompressible runs
+                    ip += 1 + ((ip - anchor) >> 6);
+                    continue;
+                }
+
+                size_t ref = candidate - 1;
+                while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+                    --ip;
+                    --ref;
+                }
+
+                size_t match_len = min_match;
+                while (ip + match_len < match_end && src[ref + match_len] == src[ip + match_len]) ++match_len;
+
+                op = write_sequence(op, src + anchor, ip - anchor, ip - ref, match_len);
+                ip += match_len;
+                anchor = ip;
+                if (ip - 2 <= ip_limit) table[hash4(load32(src + ip - 2))] = static_cast<uint32_t>(ip - 1);
+            }
+        }
+
+        size_t literal_len = len - anchor;
+        *op++ = static_cast<uint8_t>(std::min<size_t>(literal_len, 15) << 4);
+        if (literal_len >= 15) op = write_length(op, literal_len - 15);
+        memcpy(op, src + anchor, literal_len);
+        op += literal_len;
+        return static_cast<size_t>(op - dst);
+    }
+
+    int64_t lz4_decompress_block(const uint8_t* src, size_t len, uint8_t* dst, size_t cap, size_t prefix) {
+        size_t ip = 0;
+        size_t op = prefix;
+
+        while (ip < len) {
+            const uint8_t token = src[ip++];
+
+            size_t literal_len = token >> 4;
+            if (literal_len == 15) {
+                uint8_t byte;
+                do {
+                    if (ip >= len) return -1;
+                    byte = src[ip++];
+                    literal_len += byte;
+                } while (byte == 255);
+            }
+            if (literal_len > len - ip || literal_len > cap - op) return -1;
+            memcpy(dst + op, src + ip, literal_len);
+            ip += literal_len;
+            op += literal_len;
+
+            if (ip == len) break;  // the last sequence has literals only
+            if (len - ip < 2) return -1;
+
+            const size_t offset = static_cast<size_t>(src[ip]) | static_cast<size_t>(src[ip + 1]) << 8;
+            ip += 2;
+            if (offset == 0 || offset > op) return -1;
+
+            size_t match_len = token & 15;
+            if (match_len == 15) {
+                uint8_t byte;
+                do {
+                    if (ip >= len) return -1;
+                    byte = src[ip++];
+                    match_len += byte;
+                } while (byte == 255);
+            }
+            match_len += min_match;
+            if (match_len > cap - op) return -1;
+
+            const uint8_t* match = dst + op - offset;
+            if (offset >= match_len) {
+                memcpy(dst + op, match, match_len);
+            } else {
+                // Overlapping copy repeats the last offset bytes
+                for (size_t i = 0; i < match_len; ++i) dst[op + i] = match[i];
+            }
+            op += match_len;
+        }
+
+        return static_cast<int64_t>(op - prefix);
+    }
+
+    // xxHash32 for inputs under 16 bytes, which is all the frame header checksum needs
+    static uint32_t xxh32_short(const uint8_t* data, size_t len) {
+        constexpr uint32_t prime1 = 2654435761u, prime2 = 2246822519u, prime3 = 3266489917u;
+        constexpr uint32_t prime4 = 668265263u, prime5 = 374761393u;
+        auto rotl = [](uint32_t x, int r) { return (x << r) | (x >> (32 - r)); };
+
+        uint32_t h = prime5 + static_cast<uint32_t>(len);
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) h = rotl(h + load_le32(data + i) * prime3, 17) * prime4;
+        for (; i < len; ++i) h = rotl(h + data[i] * prime5, 11) * prime1;
+
+        h ^= h >> 15;
+        h *= prime2;
+        h ^= h >> 13;
+        h *= prime3;
+        h ^= h >> 16;
+        return h;
+    }
+
+    class Lz4Compressor : public CodecStream {
+    public:
+        int update(const uint8_t* data, size_t len, ChunkCallback callback, void* context) override {
+            while (len > 0) {
+                size_t take = std::min(len, frame_block_size - block.size());
+                block.insert(block.end(), data, data + take);
+                data += take;
+                len -= take;
+                if (block.size() == frame_block_size) emit_block(callback, context);
+            }
+            return 0;
+        }
+
+        int finish(ChunkCallback callback, void* context) override {
+            if (!block.empty() || !started) emit_block(callback, context);
+            uint8_t end_mark[4] = { 0, 0, 0, 0 };
+            callback(end_mark, sizeof(end_mark), context);
+            return 0;
+        }
+
+    private:
+        void emit_block(ChunkCallback callback, void* context) {
+            size_t offset = 0;
+            out.resize(7 + 4 + lz4_bound(frame_block_size));
+
+            if (!started) {
+                // FLG: version 01, independent blocks; BD: 64KB max block size
+                store_le32(out.data(), frame_magic);
+                out[4] = 0x60;
+                out[5] = 0x40;
+                out[6] = static_cast<uint8_t>(xxh32_short(out.data() + 4, 2) >> 8);
+                offset = 7;
+                started = true;
+            }
+
+            if (!block.empty()) {
+                size_t size = lz4_compress_block(block.data(), block.size(), out.data() + offset + 4);
+                if (size >= block.size()) {
+                    // Incompressible: store raw, flagged by the high bit of the size
+                    memcpy(out.data() + offset + 4, block.data(), block.size());
+                    store_le32(out.data() + offset, static_cast<uint32_t>(block.size()) | 0x80000000u);
+                    size = block.size();
+                } else {
+                    store_le32(out.data() + offset, static_cast<uint32_t>(size));
+                }
+                offset += 4 + size;
+            }
+
+            callback(out.data(), offset, context);
+            block.clear();
+        }
+
+        std::vector<uint8_t> block;
+        std::vector<uint8_t> out;
+        bool started = false;
+    };
+
+    class Lz4Decompressor : public CodecStream {
+    public:
+        int update(const uint8_t* data, size_t len, ChunkCallback callback, void* context) override {
+            if (failed) return -1;
+
+            // Parse straight from the input and only buffer an incomplete tail
+            if (pending.empty()) {
+                size_t used = parse(data, len, callback, context);
+                if (failed) return -1;
+                pending.assign(data + used, data + len);
+                return 0;
+            }
+
+            pending.insert(pending.end(), data, data + len);
+            size_t used = parse(pending.data(), pending.size(), callback, context);
+            if (failed) return -1;
+            pending.erase(pending.begin(), pending.begin() + used);
+            return 0;
+        }
+
+        int finish(ChunkCallback, void*) override {
+            return failed || !pending.empty() || state != State::Magic || !frames ? -1 : 0;
+        }
+
+    private:
+        enum class State { Magic, Header, Block, Skip };
+
+        // Consume as many whole header/block units as are available; returns bytes used
+        size_t parse(const uint8_t* data, size_t len, ChunkCallback callback, void* context) {
+            size_t pos = 0;
+            while (!failed) {
+                const size_t available = len - pos;
+                const uint8_t* p = data + pos;
+
+                if (state == State::Magic) {
+                    if (available < 4) break;
+                    uint32_t magic = load_le32(p);
+                    if (magic == frame_magic) {
+                        state = State::Header;
+                        pos += 4;
+                    } else if ((magic & 0xFFFFFFF0u) == 0x184D2A50u) {
+                        // Skippable frame: magic, 4-byte size, payload
+                        if (available < 8) break;
+                        skip = load_le32(p + 4);
+                        state = State::Skip;
+                        pos += 8;
+                    } else {
+                        failed = true;
+                    }
+                } else if (state == State::Skip) {
+                    size_t take = std::min<size_t>(skip, available);
+                    skip -= take;
+                    pos += take;
+                    if (skip) break;
+                    state = State::Magic;
+                } else if (state == State::Header) {
+                    if (available < 2) break;
+                    flags = p[0];
+                    size_t header_len = 3 + ((flags & 0x08) ? 8 : 0) + ((flags & 0x01) ? 4 : 0);
+                    if (available < header_len) break;
+
+                    int size_code = (p[1] >> 4) & 0x07;
+                    if ((flags >> 6) != 1 || size_code < 4) {
+                        failed = true;
+                        break;
+                    }
+                    block_max = size_t(1) << (8 + 2 * size_code);
+                    window.resize(history_size + block_max);
+                    history = 0;
+                    state = State::Block;
+                    pos += header_len;
+                } else {
+                    if (available < 4) break;
+                    uint32_t size_field = load_le32(p);
+                    if (size_field == 0) {
+                        size_t trailer = 4 + ((flags & 0x04) ? 4 : 0);  // end mark + content checksum
+                        if (available < trailer) break;
+                        pos += trailer;
+                        state = State::Magic;
+                        ++frames;
+                        continue;
+                    }
+
+                    const bool raw = size_field & 0x80000000u;
+                    const size_t size = size_field & 0x7FFFFFFFu;
+                    const size_t checksum = (flags & 0x10) ? 4 : 0;
+                    if (size > block_max) {
+                        failed = true;
+                        break;
+                    }
+                    if (available < 4 + size + checksum) break;
+
+                    decode_block(p + 4, size, raw, callback, context);
+                    pos += 4 + size + checksum;
+                }
+            }
+            return pos;
+        }
+
+        void decode_block(const uint8_t* src, size_t size, bool raw, ChunkCallback callback, void* context) {
+            // Linked blocks may reference the previous 64KB of output
+            const size_t prefix = (flags & 0x20) ? 0 : history;
+            int64_t n;
+            if (raw) {
+                memcpy(window.data() + prefix, src, size);
+                n = static_cast<int64_t>(size);
+            } else {
+                n = lz4_decompress_block(src, size, window.data(), prefix + block_max, prefix);
+            }
+            if (n < 0) {
+                failed = true;
+                return;
+            }
+
+            callback(window.data() + prefix, static_cast<size_t>(n), context);
+
+            if (!(flags & 0x20)) {
+                size_t total = prefix + static_cast<size_t>(n);
+                history = std::min(total, history_size);
+                memmove(window.data(), window.data() + total - history, history);
+            }
+        }
+
+        State state = State::Magic;
+        std::vector<uint8_t> pending;
+        std::vector<uint8_t> window;
+        size_t block_max = 0;
+        size_t history = 0;
+        uint32_t skip = 0;
+        uint8_t flags = 0;
+        uint64_t frames = 0;
+        bool failed = false;
+    };
+
+    std::unique_ptr<CodecStream> make_lz4_compressor() {
+        return std::unique_ptr<CodecStream>(new Lz4Compressor());
+    }
+
+    std::unique_ptr<CodecStream> make_lz4_decompressor() {
+        return std::unique_ptr<CodecStream>(new Lz4Decompressor());
+    }
+}
@@ -0,0 +1,114 @@
+#include "kernels.hpp"
+#include <cstring>
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+namespace kernels {
+    const uint8_t* find_byte(const uint8_t* data, size_t len, uint8_t byte) {
+#ifdef __wasm_simd128__
+        const v128_t target = wasm_i8x16_splat(static_cast<int8_t>(byte));
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            uint32_t mask = wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_load(data + i), target));
+            if (mask) return data + i + __builtin_ctz(mask);
+        }
+        for (; i < len; ++i) {
+            if (data[i] == byte) return data + i;
+        }
+        return nullptr;
+#else
+        return static_cast<const uint8_t*>(memchr(data, byte, len));
+#endif
+    }
+
+    const uint8_t* find_bytes(const uint8_t* data, size_t len, const uint8_t* needle, size_t needle_len) {
+        if (needle_len == 0) return data;
+        if (needle_len > len) return nullptr;
+        if (needle_len == 1) return find_byte(data, len, needle[0]);
+
+        const size_t last = needle_len - 1;
+        const size_t limit = len - needle_len;  // last valid start offset
+        size_t i = 0;
+
+#ifdef __wasm_simd128__
+        // Compare the first and last needle bytes at 16 candidate offsets at once,
+        // then verify only the candidates where both match
+        const v128_t first = wasm_i8x16_splat(static_cast<int8_t>(needle[0]));
+        const v128_t tail = wasm_i8x16_splat(static_cast<int8_t>(needle[last]));
+        for (; i + 16 <= limit + 1; i += 16) {
+            v128_t hit = wasm_v128_and(
+                wasm_i8x16_eq(wasm_v128_load(data + i), first),
+                wasm_i8x16_eq(wasm_v128_load(data + i + last), tail));
+            uint32_t mask = wasm_i8x16_bitmask(hit);
+            while (mask) {
+                size_t offset = i + __builtin_ctz(mask);
+                if (memcmp(data + offset + 1, needle + 1, needle_len - 2) == 0) return data + offset;
+                mask &= mask - 1;
+            }
+        }
+#endif
+
+        while (i <= limit) {
+            const uint8_t* candidate = find_byte(data + i, limit - i + 1, needle[0]);
+            if (!candidate) return nullptr;
+            size_t offset = static_cast<size_t>(candidate - data);
+            if (data[offset + last] == needle[last] && memcmp(candidate + 1, needle + 1, needle_len - 2) == 0) {
+                return candidate;
+            }
+            i = offset + 1;
+        }
+        return nullptr;
+    }
+
+    size_t count_byte(const uint8_t* data, size_t len, uint8_t byte) {
+        size_t count = 0;
+        size_t i = 0;
+#ifdef __wasm_simd128__
+        const v128_t target = wasm_i8x16_splat(static_cast<int8_t>(byte));
+        for (; i + 16 <= len; i += 16) {
+            count += __builtin_popcount(wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_load(data + i), target)));
+        }
+#endif
+        for (; i < len; ++i) {
+            count += data[i] == byte;
+        }
+        return count;
+    }
+
+    static inline bool is_space(uint8_t c) {
+        return c == ' ' || static_cast<uint8_t>(c - '\t') <= '\r' - '\t';
+    }
+
+    void TextCounter::update(const uint8_t* data, size_t len) {
+        bytes += len;
+        size_t i = 0;
+#ifdef __wasm_simd128__
+        const v128_t newline = wasm_i8x16_splat('\n');
+        const v128_t space = wasm_i8x16_splat(' ');
+        const v128_t tab = wasm_i8x16_splat('\t');
+        const v128_t span = wasm_i8x16_splat('\r' - '\t');
+        for (; i + 16 <= len; i += 16) {
+            v128_t chunk = wasm_v128_load(data + i);
+            lines += __builtin_popcount(wasm_i8x16_bitmask(wasm_i8x16_eq(chunk, newline)));
+
+            // Whitespace is ' ' or '\t'..'\r'; a word starts at a non-space byte after a space
+            v128_t ws = wasm_v128_or(
+                wasm_i8x16_eq(chunk, space),
+                wasm_u8x16_le(wasm_i8x16_sub(chunk, tab), span));
+            uint32_t ws_mask = wasm_i8x16_bitmask(ws);
+            uint32_t prev_ws = ((ws_mask << 1) | (in_space ? 1u : 0u)) & 0xFFFF;
+            words += __builtin_popcount(~ws_mask & prev_ws & 0xFFFF);
+            in_space = (ws_mask >> 15) & 1;
+        }
+#endif
+        for (; i < len; ++i) {
+            uint8_t c = data[i];
+            lines += c == '\n';
+            bool space = is_space(c);
+            words += in_space && !space;
+            in_space = space;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+// Cold-start loader (see loader.js): streaming compilation, a Cache API copy of the .wasm
+// and a lazy mode that defers instantiation to first use
+declare module '@ecmaos/bios/loader' {
+  import type { BIOSModule, BIOSOptions, CreateBIOS } from '@ecmaos/bios'
+
+  export interface BIOSLoaderOptions extends BIOSOptions {
+    // Build to load when wasmUrl is not given: 'bios' (default), 'bios.min' or 'bios.threads'
+    variant?: 'bios' | 'bios.min' | 'bios.threads'
+    wasmUrl?: string | URL
+    // Keep the .wasm in Cache Storage (default true where available)
+    cache?: boolean
+    cacheName?: string
+    // Tag for the cached copy, e.g. the package version; changing it refetches. Without one
+    // the cached copy is revalidated with the server (a conditional request) before use.
+    cacheKey?: string
+  }
+
+  export interface LazyBIOS {
+    // Instantiates (once) and calls _init on first use
+    get(): Promise<BIOSModule>
+    readonly loaded: boolean
+  }
+
+  export function defaultWasmUrl(variant?: string): string
+  // Begin compiling without instantiating; resolves to null where streaming does not apply
+  export function preloadBIOS(options?: BIOSLoaderOptions): Promise<WebAssembly.Module | null>
+  export function loadBIOS(createBIOS: CreateBIOS, options?: BIOSLoaderOptions): Promise<BIOSModule>
+  export function lazyBIOS(createBIOS: CreateBIOS, options?: BIOSLoaderOptions): LazyBIOS
+  export function clearBIOSCache(): Promise<void>
+}
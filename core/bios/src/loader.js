@@ -0,0 +1,196 @@
+// Cold-start loader for the BIOS. createBIOS on its own fetches and compiles bios.wasm on
+// every page load. This loader instead compiles with WebAssembly.compileStreaming, which
+// overlaps compilation with the download. It keeps the .wasm Response in the Cache API,
+// and hands the compiled module to createBIOS through its instantiateWasm hook.
+//
+//   import createBIOS from '@ecmaos/bios'
+//   import { loadBIOS } from '@ecmaos/bios/loader'
+//   const bios = await loadBIOS(createBIOS, { cacheKey: '0.2.0' })
+//
+// The Response is cached rather than the WebAssembly.Module. Browsers no longer store
+// modules in IndexedDB, but V8 keeps its compiled code alongside Cache API entries, so a
+// compileStreaming of a cached Response skips most of the compile on the next load. The
+// swapi service worker serves .wasm from these caches as well.
+
+const CACHE_PREFIX = 'ecmaos-bios-'
+const DEFAULT_CACHE_NAME = `${CACHE_PREFIX}v1`
+
+// In-flight or finished compiles by URL, so preloadBIOS and loadBIOS share one compile
+const compiles = new Map()
+
+export function defaultWasmUrl(variant = 'bios') {
+    return new URL(`../build/dist/${variant}.wasm`, import.meta.url).href
+}
+
+const canStream = (url) =>
+    typeof WebAssembly.compileStreaming === 'function' && typeof fetch === 'function' &&
+    !url.startsWith('file:')
+
+const hasCacheStorage = () => typeof caches !== 'undefined' && typeof caches.open === 'function'
+
+// compileStreaming needs Content-Type: application/wasm; if a server gets that wrong,
+// compile the bytes instead
+async function compileResponse(response) {
+    try {
+        return await WebAssembly.compileStreaming(response.clone())
+    } catch (err) {
+        if (!(err instanceof TypeError)) throw err
+        return WebAssembly.compile(await response.arrayBuffer())
+    }
+}
+
+async function fetchWasm(url) {
+    const response = await fetch(url, { credentials: 'same-origin' })
+    if (!response.ok) throw new Error(`BIOS: fetching ${url} failed with ${response.status}`)
+    return response
+}
+
+// Cache entries are keyed by URL, tagged with cacheKey when one is given
+const entryKey = (url, cacheKey) =>
+    cacheKey ? `${url}${url.includes('?') ? '&' : '?'}bios=${encodeURIComponent(cacheKey)}` : url
+
+// Cached Response for url. With a cacheKey the entry is used as-is (a new key refetches).
+// Without one the entry may be older than the glue loading it, so it is revalidated
+// first: a 304 keeps it, a 200 replaces it, and offline or on a server error it is used
+// anyway.
+async function cachedResponse(url, { cacheName, cacheKey }) {
+    const cache = await caches.open(cacheName)
+    const key = entryKey(url, cacheKey)
+    const entry = (response, fromCache) => ({ response, fromCache, evict: () => cache.delete(key) })
+
+    const hit = await cache.match(key)
+    if (hit && cacheKey) return entry(hit, true)
+
+    if (hit) {
+        const headers = {}
+        const etag = hit.headers.get('ETag')
+        const modified = hit.headers.get('Last-Modified')
+        if (etag) headers['If-None-Match'] = etag
+        if (modified) headers['If-Modified-Since'] = modified
+        try {
+            const response = await fetch(url, { headers, cache: 'no-cache', credentials: 'same-origin' })
+            if (response.status === 200) {
+                await cache.put(key, response.clone())
+                return entry(response, false)
+            }
+        } catch {}
+        return entry(hit, true)
+    }
+
+    const response = await fetchWasm(url)
+    await cache.put(key, response.clone())
+    return entry(response, false)
+}
+
+// Drop BIOS caches other than the one in use
+async function pruneCaches(cacheName) {
+    const names = await caches.keys()
+    await Promise.all(names
+        .filter(name => name.startsWith(CACHE_PREFIX) && name !== cacheName)
+        .map(name => caches.delete(name)))
+}
+
+async function compile(url, { cache = true, cacheName = DEFAULT_CACHE_NAME, cacheKey = '' } = {}) {
+    if (!cache || !hasCacheStorage()) return compileResponse(await fetchWasm(url))
+
+    let entry
+    try {
+        entry = await cachedResponse(url, { cacheName, cacheKey })
+    } catch {
+        // Cache storage can be unavailable (private browsing, opaque origins)
+        return compileResponse(await fetchWasm(url))
+    }
+
+    if (!entry.fromCache) pruneCaches(cacheName).catch(() => {})
+    try {
+        return await compileResponse(entry.response)
+    } catch (err) {
+        if (!entry.fromCache) throw err
+        // A corrupt or truncated entry: discard it and go to the network
+        await entry.evict()
+        return compileResponse(await fetchWasm(url))
+    }
+}
+
+// Start compiling as early as possible (e.g. at page load) without instantiating. Later
+// loadBIOS/lazyBIOS calls for the same URL reuse this compile.
+export function preloadBIOS(options = {}) {
+    const url = options.wasmUrl ? String(options.wasmUrl) : defaultWasmUrl(options.variant)
+    if (!canStream(url)) return Promise.resolve(null)
+
+    let pending = compiles.get(url)
+    if (!pending) {
+        pending = compile(url, options)
+        compiles.set(url, pending)
+        pending.catch(() => compiles.delete(url))
+    }
+    return pending
+}
+
+// Instantiate the BIOS from the (cached, streaming) compiled module. Options are passed to
+// createBIOS, except for the loader's own: variant, wasmUrl, cache, cacheName and cacheKey.
+// Where streaming does not apply (Node, file: URLs), createBIOS loads the .wasm itself.
+export async function loadBIOS(createBIOS, options = {}) {
+    const { variant, wasmUrl, cache, cacheName, cacheKey, ...moduleOptions } = options
+    const url = wasmUrl ? String(wasmUrl) : defaultWasmUrl(variant)
+    if (!canStream(url) || moduleOptions.instantiateWasm) return createBIOS(moduleOptions)
+
+    const compiled = preloadBIOS({ wasmUrl: url, cache, cacheName, cacheKey })
+
+    // instantiateWasm is asynchronous from emscripten's side; failures surface through
+    // this promise instead
+    let fail
+    const failed = new Promise((_, reject) => { fail = reject })
+
+    const bios = createBIOS({
+        ...moduleOptions,
+        instantiateWasm(imports, receiveInstance) {
+            compiled
+                .then(module => WebAssembly.instantiate(module, imports)
+                    .then(instance => receiveInstance(instance, module)))
+                .catch(async err => {
+                    // A module cached from an older build may not link against this glue:
+                    // drop it and retry once from the network
+                    if (!(err instanceof WebAssembly.LinkError) || cache === false || !hasCacheStorage()) throw err
+                    compiles.delete(url)
+                    const store = await caches.open(cacheName || DEFAULT_CACHE_NAME)
+                    await store.delete(entryKey(url, cacheKey || ''))
+                    const module = await preloadBIOS({ wasmUrl: url, cache, cacheName, cacheKey })
+                    receiveInstance(await WebAssembly.instantiate(module, imports), module)
+                })
+                .catch(fail)
+            return {}
+        }
+    })
+    return Promise.race([bios, failed])
+}
+
+// Lazy mode: compile now, instantiate on first get(). Instantiation allocates the heap and
+// boots the runtime, so pages that may never run a command need not pay for it up front.
+export function lazyBIOS(createBIOS, options = {}) {
+    preloadBIOS(options).catch(() => {})
+
+    let instance = null
+    return {
+        get() {
+            if (!instance) {
+                instance = loadBIOS(createBIOS, options).then(bios => {
+                    bios._init()
+                    return bios
+                })
+                instance.catch(() => { instance = null })
+            }
+            return instance
+        },
+        get loaded() {
+            return instance !== null
+        }
+    }
+}
+
+// Remove every cached BIOS module
+export async function clearBIOSCache() {
+    if (!hasCacheStorage()) return
+    compiles.clear()
+    await pruneCaches('')
+}
@@ -0,0 +1,88 @@
+#include "arena.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace runtime {
+    Arena::Arena(size_t block_size) : block_size(block_size) {}
+
+    Arena::~Arena() {
+        while (head) {
+            Block* next = head->next;
+            free(head);
+            head = next;
+        }
+    }
+
+    Arena::Block* Arena::new_block(size_t min_size) {
+        size_t size = min_size > block_size ? min_size : block_size;
+        auto* block = static_cast<Block*>(malloc(header_size + size));
+        if (!block) {
+#if defined(__cpp_exceptions)
+            throw std::bad_alloc();
+#else
+            abort();  // WASI SDK builds have no exceptions
+#endif
+        }
+
+        block->size = size;
+        block->offset = 0;
+        block->next = head;
+        head = block;
+        return block;
+    }
+
+    void* Arena::allocate(size_t size, size_t alignment) {
+        if (alignment == 0) alignment = 1;
+
+        Block* block = head;
+        uintptr_t base = block ? reinterpret_cast<uintptr_t>(block) + header_size : 0;
+        size_t aligned = block ? ((base + block->offset + alignment - 1) & ~(alignment - 1)) - base : 0;
+
+        if (!block || aligned + size > block->size) {
+            block = new_block(size + alignment);
+            base = reinterpret_cast<uintptr_t>(block) + header_size;
+            aligned = ((base + alignment - 1) & ~(alignment - 1)) - base;
+        }
+
+        block->offset = aligned + size;
+        used_bytes += size;
+        return reinterpret_cast<void*>(base + aligned);
+    }
+
+    void Arena::reset() {
+        // Keep only the oldest standard-size block; oversized and overflow blocks go back to malloc
+        Block* keep = nullptr;
+        while (head) {
+            Block* next = head->next;
+            if (!next && head->size == block_size) {
+                keep = head;
+            } else {
+                free(head);
+            }
+            head = next;
+        }
+
+        head = keep;
+        if (head) {
+            head->next = nullptr;
+            head->offset = 0;
+        }
+        used_bytes = 0;
+    }
+
+    Arena& scratch_arena() {
+        static thread_local Arena arena;
+        return arena;
+    }
+
+    static thread_local int scratch_depth = 0;
+
+    ScratchScope::ScratchScope() {
+        ++scratch_depth;
+    }
+
+    ScratchScope::~ScratchScope() {
+        if (--scratch_depth == 0) scratch_arena().reset();
+    }
+}
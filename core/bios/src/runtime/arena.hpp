@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace runtime {
+    // Bump allocator for per-command scratch memory. Allocation is a pointer bump
+    // inside a block; nothing is freed individually. reset() releases every block
+    // except the first, which is kept for the next command so a long-lived heap
+    // does not fragment under the churn of short-lived strings and buffers.
+    class Arena {
+    public:
+        static constexpr size_t default_block_size = 256 * 1024;
+
+        explicit Arena(size_t block_size = default_block_size);
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+        void reset();
+
+        // Bytes handed out since the last reset
+        size_t used() const { return used_bytes; }
+
+    private:
+        struct Block {
+            Block* next;
+            size_t size;
+            size_t offset;
+        };
+
+        static constexpr size_t header_size =
+            (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+        Block* new_block(size_t min_size);
+
+        Block* head = nullptr;
+        size_t block_size;
+        size_t used_bytes = 0;
+    };
+
+    // The calling thread's scratch arena
+    Arena& scratch_arena();
+
+    // Marks one command invocation; the scratch arena is reset when the outermost scope ends.
+    // Scratch allocations must not outlive the scope that made them.
+    class ScratchScope {
+    public:
+        ScratchScope();
+        ~ScratchScope();
+
+        ScratchScope(const ScratchScope&) = delete;
+        ScratchScope& operator=(const ScratchScope&) = delete;
+    };
+
+    // Standard allocator over the thread's scratch arena; deallocate is a no-op
+    template <typename T>
+    struct ScratchAllocator {
+        typedef T value_type;
+
+        ScratchAllocator() = default;
+        template <typename U>
+        ScratchAllocator(const ScratchAllocator<U>&) {}
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(scratch_arena().allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(T*, size_t) {}
+
+        template <typename U>
+        bool operator==(const ScratchAllocator<U>&) const { return true; }
+        template <typename U>
+        bool operator!=(const ScratchAllocator<U>&) const { return false; }
+    };
+
+    typedef std::basic_string<char, std::char_traits<char>, ScratchAllocator<char>> ScratchString;
+
+    template <typename T>
+    using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+}
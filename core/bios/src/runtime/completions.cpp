@@ -0,0 +1,27 @@
+#include "completions.hpp"
+#include "platform.hpp"
+
+namespace runtime {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "CompletionRing layout is shared with JS");
+
+    static Mutex producer_mutex;
+
+    CompletionRing& completion_ring() {
+        static CompletionRing ring;
+        return ring;
+    }
+
+    void push_completion(int job_id, int code) {
+        CompletionRing& ring = completion_ring();
+        LockGuard lock(producer_mutex);
+
+        uint32_t head = ring.head.load(std::memory_order_relaxed);
+        if (head - ring.tail.load(std::memory_order_acquire) >= ring.capacity) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        ring.entries[head % ring.capacity] = { job_id, code };
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+}
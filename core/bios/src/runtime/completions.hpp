@@ -0,0 +1,30 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace runtime {
+    // Job completions published to JS through linear memory. Layout (int32):
+    //   [0] capacity  [1] head (next write)  [2] tail (next read, advanced by JS)  [3] dropped
+    //   then capacity entries of [job id, exit code]
+    // Producers are pool workers; JS drains entries from tail to head and stores the new tail.
+    struct CompletionRing {
+        static constexpr uint32_t capacity_entries = 256;
+
+        struct Entry {
+            int32_t job_id;
+            int32_t code;
+        };
+
+        uint32_t capacity = capacity_entries;
+        std::atomic<uint32_t> head { 0 };
+        std::atomic<uint32_t> tail { 0 };
+        std::atomic<uint32_t> dropped { 0 };
+        Entry entries[capacity_entries] = {};
+    };
+
+    CompletionRing& completion_ring();
+
+    // Append a completion; if JS has not drained the ring it is counted in dropped
+    // (the job's state is still available through poll_job)
+    void push_completion(int job_id, int code);
+}
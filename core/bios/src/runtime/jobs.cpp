@@ -0,0 +1,81 @@
+#include "jobs.hpp"
+#include "pool.hpp"
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+namespace runtime {
+    struct Job {
+        std::atomic<int> state { static_cast<int>(JobState::Pending) };
+        int code = 0;
+        std::string output;
+        Mutex mutex;
+        ConditionVariable done;
+    };
+
+    static Mutex table_mutex;
+    static std::unordered_map<int, std::shared_ptr<Job>> job_table;
+    static int next_job_id = 1;
+
+    static std::shared_ptr<Job> find_job(int id) {
+        LockGuard lock(table_mutex);
+        auto it = job_table.find(id);
+        return it == job_table.end() ? nullptr : it->second;
+    }
+
+    int submit_job(JobFunction function, CompletionCallback on_complete) {
+        auto job = std::make_shared<Job>();
+        int id;
+        {
+            LockGuard lock(table_mutex);
+            id = next_job_id++;
+            job_table.emplace(id, job);
+        }
+
+        WorkerPool::instance().submit([id, job, function = std::move(function), on_complete] {
+            job->state.store(static_cast<int>(JobState::Running), std::memory_order_release);
+            int code = function(job->output);
+            {
+                LockGuard lock(job->mutex);
+                job->code = code;
+                job->state.store(static_cast<int>(JobState::Done), std::memory_order_release);
+            }
+            job->done.notify_all();
+            if (on_complete) on_complete(id, code);
+        });
+
+        return id;
+    }
+
+    JobState poll_job(int id) {
+        auto job = find_job(id);
+        if (!job) return JobState::Unknown;
+        return static_cast<JobState>(job->state.load(std::memory_order_acquire));
+    }
+
+    int wait_job(int id) {
+        auto job = find_job(id);
+        if (!job) return -1;
+
+        UniqueLock lock(job->mutex);
+        job->done.wait(lock, [&] {
+            return job->state.load(std::memory_order_acquire) == static_cast<int>(JobState::Done);
+        });
+        return job->code;
+    }
+
+    const std::string* job_output(int id) {
+        auto job = find_job(id);
+        if (!job || job->state.load(std::memory_order_acquire) != static_cast<int>(JobState::Done)) return nullptr;
+        return &job->output;
+    }
+
+    int release_job(int id) {
+        LockGuard lock(table_mutex);
+        auto it = job_table.find(id);
+        if (it == job_table.end()) return -1;
+        if (it->second->state.load(std::memory_order_acquire) != static_cast<int>(JobState::Done)) return -1;
+        job_table.erase(it);
+        return 0;
+    }
+}
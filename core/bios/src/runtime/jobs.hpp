@@ -0,0 +1,33 @@
+#pragma once
+#include <functional>
+#include <string>
+
+namespace runtime {
+    // Job states; values are shared with JS (see BIOSJobState in bios.d.ts)
+    enum class JobState : int {
+        Unknown = -1,
+        Pending = 0,
+        Running = 1,
+        Done = 2
+    };
+
+    // Body of a job: writes its output and returns the exit code
+    typedef std::function<int(std::string& output)> JobFunction;
+
+    // Called on the worker after a job finishes
+    typedef void (*CompletionCallback)(int id, int code);
+
+    // Queue a job on the worker pool and return its id (> 0)
+    int submit_job(JobFunction function, CompletionCallback on_complete = nullptr);
+
+    JobState poll_job(int id);
+
+    // Block until the job finishes; returns its exit code, or -1 for an unknown id
+    int wait_job(int id);
+
+    // Output of a finished job, owned by the job table until release_job; nullptr if not done
+    const std::string* job_output(int id);
+
+    // Drop a finished job and its output; returns 0, or -1 if it is unknown or still running
+    int release_job(int id);
+}
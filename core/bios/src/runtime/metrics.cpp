@@ -0,0 +1,100 @@
+#include "metrics.hpp"
+#include "platform.hpp"
+#include <cstdio>
+#include <map>
+
+namespace runtime {
+    // std::map keeps references stable across inserts and iterates in name order
+    typedef std::map<std::string, Metric, std::less<>> MetricTable;
+
+    static Mutex metrics_mutex;
+    static MetricTable export_metrics;
+    static MetricTable command_metrics;
+
+    Metric& metric(MetricKind kind, std::string_view name) {
+        LockGuard lock(metrics_mutex);
+        MetricTable& table = kind == MetricKind::Export ? export_metrics : command_metrics;
+        auto it = table.find(name);
+        if (it == table.end()) it = table.emplace(std::string(name), Metric()).first;
+        return it->second;
+    }
+
+    static size_t latency_bucket(double elapsed_ms) {
+        uint64_t micros = elapsed_ms > 0 ? static_cast<uint64_t>(elapsed_ms * 1000.0) : 0;
+        if (micros == 0) return 0;
+        size_t bucket = static_cast<size_t>(64 - __builtin_clzll(micros));
+        return bucket < latency_buckets ? bucket : latency_buckets - 1;
+    }
+
+    void record(Metric& metric, double elapsed_ms, size_t bytes_in, size_t bytes_out) {
+        const size_t bucket = latency_bucket(elapsed_ms);
+
+        LockGuard lock(metrics_mutex);
+        ++metric.calls;
+        metric.bytes_in += bytes_in;
+        metric.bytes_out += bytes_out;
+        metric.total_ms += elapsed_ms;
+        if (elapsed_ms > metric.max_ms) metric.max_ms = elapsed_ms;
+        ++metric.latency[bucket];
+    }
+
+    MetricScope::MetricScope(Metric& metric, size_t bytes_in)
+        : target(metric), start(now_ms()), bytes_in(bytes_in) {}
+
+    MetricScope::~MetricScope() {
+        record(target, now_ms() - start, bytes_in, bytes_out);
+    }
+
+    static void append_table(std::string& out, const char* key, const MetricTable& table) {
+        char number[32];
+        out += '"';
+        out += key;
+        out += "\":{";
+
+        bool first = true;
+        for (const auto& entry : table) {
+            const Metric& metric = entry.second;
+            if (!metric.calls) continue;
+            if (!first) out += ',';
+            first = false;
+
+            out += '"';
+            out += entry.first;
+            out += "\":{\"calls\":";
+            out += std::to_string(metric.calls);
+            out += ",\"bytesIn\":";
+            out += std::to_string(metric.bytes_in);
+            out += ",\"bytesOut\":";
+            out += std::to_string(metric.bytes_out);
+            snprintf(number, sizeof(number), "%.3f", metric.total_ms);
+            out += ",\"totalMs\":";
+            out += number;
+            snprintf(number, sizeof(number), "%.3f", metric.max_ms);
+            out += ",\"maxMs\":";
+            out += number;
+            out += ",\"latencyLog2Us\":[";
+            for (size_t i = 0; i < latency_buckets; ++i) {
+                if (i) out += ',';
+                out += std::to_string(metric.latency[i]);
+            }
+            out += "]}";
+        }
+
+        out += '}';
+    }
+
+    void append_metrics_json(std::string& out) {
+        LockGuard lock(metrics_mutex);
+        append_table(out, "exports", export_metrics);
+        out += ',';
+        append_table(out, "commands", command_metrics);
+    }
+
+    void reset_metrics() {
+        // Entries stay allocated because callers hold references to them
+        LockGuard lock(metrics_mutex);
+        for (auto* table : { &export_metrics, &command_metrics }) {
+            for (auto& entry : *table) entry.second = Metric();
+        }
+    }
+}
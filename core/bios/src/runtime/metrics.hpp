@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace runtime {
+    enum class MetricKind {
+        Export,
+        Command
+    };
+
+    // Bucket 0 is under 1us; bucket i (i > 0) holds [2^(i-1), 2^i) us; the last is open-ended
+    constexpr size_t latency_buckets = 24;
+
+    struct Metric {
+        uint64_t calls = 0;
+        uint64_t bytes_in = 0;
+        uint64_t bytes_out = 0;
+        double total_ms = 0;
+        double max_ms = 0;
+        uint64_t latency[latency_buckets] = {};
+    };
+
+    // Counters for name, created on first use. The reference stays valid for the life of
+    // the module, so callers can resolve it once into a function-local static.
+    Metric& metric(MetricKind kind, std::string_view name);
+
+    void record(Metric& metric, double elapsed_ms, size_t bytes_in, size_t bytes_out);
+
+    // Times a call from construction to destruction and records it on metric
+    class MetricScope {
+    public:
+        explicit MetricScope(Metric& metric, size_t bytes_in = 0);
+        ~MetricScope();
+
+        MetricScope(const MetricScope&) = delete;
+        MetricScope& operator=(const MetricScope&) = delete;
+
+        void add_bytes_in(size_t len) { bytes_in += len; }
+        void add_bytes_out(size_t len) { bytes_out += len; }
+
+    private:
+        Metric& target;
+        double start;
+        size_t bytes_in;
+        size_t bytes_out = 0;
+    };
+
+    // Append "exports":{...},"commands":{...} (keys sorted by name) for get_metrics
+    void append_metrics_json(std::string& out);
+
+    void reset_metrics();
+}
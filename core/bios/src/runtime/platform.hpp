@@ -0,0 +1,62 @@
+#pragma once
+
+// What the command core needs from its host, so it builds both inside the Emscripten
+// module and as a standalone WASI program (wasi_main.cpp).
+//   - A monotonic clock in milliseconds.
+//   - Locks and condition variables. WASI SDKs ship libc++ without threads, where
+//     std::mutex and friends do not exist. BIOS_NO_THREADS swaps in no-op stand-ins,
+//     which is sound because such a build only ever runs on one thread.
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#else
+#include <time.h>
+#endif
+
+#ifndef BIOS_NO_THREADS
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace runtime {
+    inline double now_ms() {
+#ifdef __EMSCRIPTEN__
+        return emscripten_get_now();
+#else
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<double>(ts.tv_sec) * 1000.0 + static_cast<double>(ts.tv_nsec) / 1e6;
+#endif
+    }
+
+#ifndef BIOS_NO_THREADS
+    typedef std::mutex Mutex;
+    typedef std::lock_guard<std::mutex> LockGuard;
+    typedef std::unique_lock<std::mutex> UniqueLock;
+    typedef std::condition_variable ConditionVariable;
+#else
+    struct Mutex {
+        void lock() {}
+        void unlock() {}
+    };
+
+    struct LockGuard {
+        explicit LockGuard(Mutex&) {}
+    };
+
+    struct UniqueLock {
+        explicit UniqueLock(Mutex&) {}
+        void lock() {}
+        void unlock() {}
+    };
+
+    // With one thread nobody else can make a predicate true, so a wait on a false one
+    // would be a deadlock; callers only wait on work that already ran inline
+    struct ConditionVariable {
+        void notify_one() {}
+        void notify_all() {}
+        template <typename Predicate>
+        void wait(UniqueLock&, Predicate) {}
+    };
+#endif
+}
@@ -0,0 +1,98 @@
+#include "pool.hpp"
+
+#ifndef BIOS_WORKERS
+#define BIOS_WORKERS 4
+#endif
+
+namespace runtime {
+    // Index of the pool worker running on this thread, or -1 outside the pool
+    static thread_local int current_worker = -1;
+
+    WorkerPool& WorkerPool::instance() {
+#ifdef __EMSCRIPTEN_PTHREADS__
+        static WorkerPool pool(BIOS_WORKERS);
+#else
+        static WorkerPool pool(0);
+#endif
+        return pool;
+    }
+
+    WorkerPool::WorkerPool(size_t count) {
+#ifndef BIOS_NO_THREADS
+        for (size_t i = 0; i < count; ++i) queues.push_back(std::make_unique<Queue>());
+        for (size_t i = 0; i < count; ++i) workers.emplace_back(&WorkerPool::run_worker, this, i);
+#else
+        (void)count;
+#endif
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            LockGuard lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+#ifndef BIOS_NO_THREADS
+        for (auto& worker : workers) worker.join();
+#endif
+    }
+
+    void WorkerPool::submit(Task task) {
+        if (queues.empty()) {
+            task();
+            return;
+        }
+
+        // Tasks spawned by a worker stay on its own deque; others are spread round-robin
+        size_t index = current_worker >= 0
+            ? static_cast<size_t>(current_worker)
+            : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        {
+            LockGuard lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+
+        {
+            LockGuard lock(sleep_mutex);
+            pending.fetch_add(1, std::memory_order_release);
+        }
+        wake.notify_one();
+    }
+
+    bool WorkerPool::pop_local(size_t index, Task& task) {
+        Queue& queue = *queues[index];
+        LockGuard lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool WorkerPool::steal(size_t thief, Task& task) {
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            Queue& victim = *queues[(thief + offset) % queues.size()];
+            LockGuard lock(victim.mutex);
+            if (victim.tasks.empty()) continue;
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void WorkerPool::run_worker(size_t index) {
+        current_worker = static_cast<int>(index);
+        for (;;) {
+            Task task;
+            if (pop_local(index, task) || steal(index, task)) {
+                pending.fetch_sub(1, std::memory_order_acq_rel);
+                task();
+                continue;
+            }
+
+            UniqueLock lock(sleep_mutex);
+            wake.wait(lock, [this] { return stopping || pending.load(std::memory_order_acquire) > 0; });
+            if (stopping) return;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "platform.hpp"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifndef BIOS_NO_THREADS
+#include <thread>
+#endif
+
+namespace runtime {
+    // Fixed-size work-stealing pool. Each worker owns a deque: it pops its own
+    // newest task and, when empty, steals the oldest task from another worker.
+    // In single-threaded builds (no __EMSCRIPTEN_PTHREADS__, or BIOS_NO_THREADS) tasks run
+    // inline on submit.
+    class WorkerPool {
+    public:
+        typedef std::function<void()> Task;
+
+        static WorkerPool& instance();
+
+        void submit(Task task);
+        size_t size() const { return queues.size(); }
+
+        ~WorkerPool();
+
+    private:
+        explicit WorkerPool(size_t count);
+
+        struct Queue {
+            Mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void run_worker(size_t index);
+        bool pop_local(size_t index, Task& task);
+        bool steal(size_t thief, Task& task);
+
+        std::vector<std::unique_ptr<Queue>> queues;
+#ifndef BIOS_NO_THREADS
+        std::vector<std::thread> workers;
+#endif
+        Mutex sleep_mutex;
+        ConditionVariable wake;
+        std::atomic<size_t> pending { 0 };
+        std::atomic<size_t> next_queue { 0 };
+        bool stopping = false;
+    };
+}
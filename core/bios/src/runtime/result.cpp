@@ -0,0 +1,67 @@
+#include "result.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace runtime {
+    static constexpr size_t min_capacity = 64 * 1024;
+    // Regions above this are given back once a call needs less than a quarter of them
+    static constexpr size_t shrink_threshold = 4 * 1024 * 1024;
+
+    ResultBuffer::~ResultBuffer() {
+        free(region);
+    }
+
+    bool ResultBuffer::reallocate(size_t capacity) {
+        if (capacity > INT32_MAX - sizeof(ResultHeader)) return false;
+
+        auto* next = static_cast<ResultHeader*>(realloc(region, sizeof(ResultHeader) + capacity));
+        if (!next) return false;
+
+        if (!region) next->length = 0;
+        region = next;
+        region->capacity = static_cast<int32_t>(capacity);
+        return true;
+    }
+
+    char* ResultBuffer::prepare(size_t len) {
+        size_t capacity = region ? static_cast<size_t>(region->capacity) : 0;
+        if (!region || len > capacity) {
+            size_t target = capacity * 2 > len ? capacity * 2 : len;
+            if (target < min_capacity) target = min_capacity;
+            if (!reallocate(target)) return nullptr;
+        } else if (capacity > shrink_threshold && len < capacity / 4) {
+            if (!reallocate(len > min_capacity ? len : min_capacity)) return nullptr;
+        }
+
+        region->length = 0;
+        region->status = 0;
+        region->reserved = 0;
+        return data();
+    }
+
+    char* ResultBuffer::grow(size_t len) {
+        if (!region) return prepare(len);
+        size_t capacity = static_cast<size_t>(region->capacity);
+        if (len <= capacity) return data();
+        return reallocate(capacity * 2 > len ? capacity * 2 : len) ? data() : nullptr;
+    }
+
+    ResultHeader* ResultBuffer::finish(int status, size_t length) {
+        if (!region) return nullptr;
+        region->status = status;
+        region->length = static_cast<int32_t>(length);
+        return region;
+    }
+
+    ResultHeader* ResultBuffer::set(int status, std::string_view data) {
+        char* out = prepare(data.size());
+        if (!out) return nullptr;
+        if (!data.empty()) memcpy(out, data.data(), data.size());
+        return finish(status, data.size());
+    }
+
+    ResultBuffer& result_buffer() {
+        static thread_local ResultBuffer buffer;
+        return buffer;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace runtime {
+    // Fixed header at the start of the shared result region; data follows immediately.
+    // JS reads it through HEAP32/HEAPU8 at the pointer an export returns.
+    struct ResultHeader {
+        int32_t length;     // bytes of data after the header
+        int32_t status;     // exit code / status of the call
+        int32_t capacity;   // bytes available for data
+        int32_t reserved;
+    };
+
+    static_assert(sizeof(ResultHeader) == 16, "ResultHeader layout is shared with JS");
+
+    // Growable result region reused by every result-returning export on a thread, so
+    // results need no malloc per call and no free from JS. The region may move when it
+    // grows; its contents are valid until the next result export on the same thread.
+    class ResultBuffer {
+    public:
+        ~ResultBuffer();
+
+        // Make room for len bytes and reset the header; returns the data area or nullptr
+        char* prepare(size_t len);
+
+        // Grow the data area to at least len bytes, keeping what is already written
+        char* grow(size_t len);
+
+        ResultHeader* finish(int status, size_t length);
+        ResultHeader* set(int status, std::string_view data);
+
+        ResultHeader* header() { return region; }
+        char* data() { return region ? reinterpret_cast<char*>(region + 1) : nullptr; }
+
+    private:
+        bool reallocate(size_t capacity);
+
+        ResultHeader* region = nullptr;
+    };
+
+    ResultBuffer& result_buffer();
+}
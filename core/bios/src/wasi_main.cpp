@@ -0,0 +1,153 @@
+// WASI entry point: the BIOS command core as a command-line program (bios.wasi.wasm) for
+// wasmtime, server-side test runs and the kernel's WASI loader. bios.cpp is the Emscripten
+// module; this file replaces it and shares everything below it.
+//
+//   bios -c 'cat /data/log | grep error | wc -l'   run one command line; stdin is the
+//                                                   first stage's input
+//   bios grep 'b error' /data/log                   run one command with these arguments
+//                                                   (no pipeline parsing), stdin as input
+//   bios < script                                   one command line per stdin line
+//
+// stdin is read only when a command reads its input, so a command that never does is
+// not held up by a writer that is slow to close the pipe. Error and usage messages go to
+// stderr, command output alone to stdout.
+//
+// Paths resolve against the host's preopened directories, e.g.
+//   wasmtime run --dir ./data::/data bios.wasi.wasm -c 'ls /data'
+#include "commands/commands.hpp"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    // Output goes to stdout as it is produced (stdio does the buffering); error and usage
+    // messages go to stderr, so a caller piping stdout only ever gets command output
+    class StdoutSink : public commands::OutputSink {
+    public:
+        void write(std::string_view data) override {
+            if (data.empty()) return;
+            fwrite(data.data(), 1, data.size(), stdout);
+            last = data.back();
+        }
+
+        void error(std::string_view message) override {
+            if (message.empty()) return;
+            fflush(stdout);
+            fwrite(message.data(), 1, message.size(), stderr);
+            last_error = message.back();
+        }
+
+        // Messages are written without newlines; end the last one on its own line
+        void finish_errors() {
+            if (last_error != '\n') fputc('\n', stderr);
+            last_error = '\n';
+        }
+
+        char last = '\n';
+        char last_error = '\n';
+    };
+
+    // stdin as a lazily read command input
+    class StdinSource : public commands::InputSource {
+    public:
+        int64_t read(uint8_t* buffer, size_t cap) override {
+            size_t n = fread(buffer, 1, cap, stdin);
+            if (n == 0 && ferror(stdin)) return -1;
+            return static_cast<int64_t>(n);
+        }
+    };
+
+    // Shell convention: 0 is success, anything else fits in a byte
+    int exit_code(int code) {
+        if (code == 0) return 0;
+        return code > 0 && code < 256 ? code : 1;
+    }
+
+    // A terminal is not input; anything else (a pipe, a file, a host stream) is
+    commands::CommandInput stdin_input(StdinSource& source) {
+        commands::CommandInput in;
+        if (!isatty(STDIN_FILENO)) {
+            in.source = &source;
+            in.piped = true;
+        }
+        return in;
+    }
+
+    // Rebuild an argument string that split_args takes apart into exactly args; false if
+    // an argument holds both quote characters, which split_args cannot express
+    bool quote_args(char** args, int count, std::string& out) {
+        for (int i = 0; i < count; ++i) {
+            const char* arg = args[i];
+            const bool single = strchr(arg, '\'') != nullptr;
+            const bool plain = *arg && !single && !strpbrk(arg, " \t\"");
+            if (single && strchr(arg, '"')) return false;
+
+            if (i > 0) out += ' ';
+            if (plain) {
+                out += arg;
+            } else {
+                const char quote = single ? '"' : '\'';
+                out += quote;
+                out += arg;
+                out += quote;
+            }
+        }
+        return true;
+    }
+
+    // One command line per input line; output of each ends with a newline so results
+    // stay separable
+    int run_script(FILE* file) {
+        int code = 0;
+        std::string line;
+        int c;
+        do {
+            c = fgetc(file);
+            if (c != EOF && c != '\n') {
+                line += static_cast<char>(c);
+                continue;
+            }
+
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.find_first_not_of(" \t") != std::string::npos) {
+                StdoutSink sink;
+                code = commands::execute_command(line, sink);
+                if (sink.last != '\n') fputc('\n', stdout);
+                sink.finish_errors();
+                fflush(stdout);
+            }
+            line.clear();
+        } while (c != EOF);
+        return code;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) return exit_code(run_script(stdin));
+
+    StdinSource source;
+    const commands::CommandInput in = stdin_input(source);
+    StdoutSink sink;
+    int code;
+
+    if (strcmp(argv[1], "-c") == 0) {
+        if (argc != 3) {
+            fprintf(stderr, "usage: %s -c 'command line' | %s command [args...]\n", argv[0], argv[0]);
+            return 2;
+        }
+        code = commands::execute_command(argv[2], sink, in);
+    } else {
+        std::string args;
+        if (!quote_args(argv + 2, argc - 2, args)) {
+            fprintf(stderr, "%s: an argument contains both ' and \"; use -c\n", argv[0]);
+            return 2;
+        }
+        runtime::ScratchScope scratch;
+        code = commands::run_command(argv[1], args, sink, in);
+    }
+
+    fflush(stdout);
+    sink.finish_errors();
+    return exit_code(code);
+}
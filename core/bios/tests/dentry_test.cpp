@@ -0,0 +1,50 @@
+// Dentry cache: a path is only cached below a cached parent, including when the cache
+// fills up mid-lookup
+#include "fs.hpp"
+#include "test.hpp"
+#include <sys/stat.h>
+
+namespace {
+    constexpr uint64_t dentry_capacity = 64 * 1024;   // dentry.cpp
+
+    void write(const std::string& path) {
+        CHECK(fs::write_bytes(path.c_str(), reinterpret_cast<const uint8_t*>("x"), 1) == 0);
+    }
+
+    void test_invalidate(const test::TempDir& dir) {
+        const std::string sub = dir / "sub";
+        CHECK(fs::lookup_path(sub.c_str()) == 0);
+        write(sub);
+        CHECK(fs::lookup_path(sub.c_str()) == 1);
+        CHECK(fs::remove_file(sub.c_str()) == 0);
+        CHECK(fs::lookup_path(sub.c_str()) == 0);
+    }
+
+    void test_full_cache(const test::TempDir& dir) {
+        const std::string parent = dir / "parent";
+        const std::string child = parent + "/child";
+        CHECK(mkdir(parent.c_str(), 0755) == 0);
+        write(child);
+        CHECK(fs::lookup_path(dir.path.c_str()) == 1);
+
+        // Fill to one below capacity with negative entries, so caching parent fills it
+        // and the lookup of child then finds it full
+        for (int i = 0; fs::dentry_cache_stats().entries < dentry_capacity - 1; ++i) {
+            fs::lookup_path((dir / ("missing-" + std::to_string(i))).c_str());
+        }
+        CHECK(fs::dentry_cache_stats().entries == dentry_capacity - 1);
+        CHECK(fs::lookup_path(child.c_str()) == 1);
+
+        // Moving parent away invalidates parent's subtree; child must not outlive it
+        CHECK(fs::move_path(parent.c_str(), (dir / "moved").c_str()) == 0);
+        CHECK(fs::lookup_path(child.c_str()) == 0);
+        CHECK(fs::lookup_path((dir / "moved/child").c_str()) == 1);
+    }
+}
+
+int main() {
+    test::TempDir dir;
+    test_invalidate(dir);
+    test_full_cache(dir);
+    return test::failures();
+}
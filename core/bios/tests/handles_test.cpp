@@ -0,0 +1,67 @@
+// File handles: positioned reads through the block cache and writes that are reported
+// once per run of writes rather than per chunk
+#include "fs.hpp"
+#include "test.hpp"
+
+namespace {
+    const uint8_t* bytes(std::string_view text) {
+        return reinterpret_cast<const uint8_t*>(text.data());
+    }
+
+    std::string contents(const std::string& path) {
+        std::string text;
+        return fs::read_all(path.c_str(), text) == 0 ? text : std::string("<unreadable>");
+    }
+
+    void test_read(const test::TempDir& dir) {
+        const std::string file = dir / "read.txt";
+        CHECK(fs::write_bytes(file.c_str(), bytes("0123456789"), 10) == 0);
+
+        int handle = fs::open_handle(file.c_str());
+        CHECK(handle > 0);
+        uint8_t buffer[4];
+        CHECK(fs::read_handle(handle, buffer, 4) == 4);
+        CHECK_EQUAL(std::string_view(reinterpret_cast<char*>(buffer), 4), "0123");
+        CHECK(fs::seek_handle(handle, -2, SEEK_END) == 8);
+        CHECK(fs::read_handle(handle, buffer, 4) == 2);
+        CHECK_EQUAL(std::string_view(reinterpret_cast<char*>(buffer), 2), "89");
+        CHECK(fs::close_handle(handle) == 0);
+        CHECK(fs::read_handle(handle, buffer, 4) == -1);
+        CHECK(fs::close_handle(handle) == -1);
+    }
+
+    // Blocks cached between writes must not survive the close
+    void test_write_visibility(const test::TempDir& dir) {
+        const std::string file = dir / "write.txt";
+        CHECK(fs::write_bytes(file.c_str(), bytes("old"), 3) == 0);
+        CHECK_EQUAL(contents(file), "old");
+
+        int handle = fs::open_handle(file.c_str(), fs::OPEN_WRITE | fs::OPEN_TRUNCATE);
+        CHECK(handle > 0);
+        CHECK(fs::write_handle(handle, bytes("first "), 6) == 6);
+        CHECK_EQUAL(contents(file), "first ");
+        CHECK(fs::write_handle(handle, bytes("second"), 6) == 6);
+        CHECK(fs::close_handle(handle) == 0);
+        CHECK_EQUAL(contents(file), "first second");
+
+        uint32_t before;
+        std::vector<fs::ChangeEvent> events;
+        fs::read_changes(0, events, before);
+        handle = fs::open_handle(file.c_str(), fs::OPEN_APPEND);
+        CHECK(fs::write_handle(handle, bytes("!"), 1) == 1);
+        CHECK(fs::close_handle(handle) == 0);
+        CHECK_EQUAL(contents(file), "first second!");
+
+        events.clear();
+        uint32_t last;
+        CHECK(fs::read_changes(before, events, last));
+        CHECK(!events.empty() && events.back().path == file && events.back().op == fs::ChangeOp::Write);
+    }
+}
+
+int main() {
+    test::TempDir dir;
+    test_read(dir);
+    test_write_visibility(dir);
+    return test::failures();
+}
@@ -0,0 +1,198 @@
+// Tree images: snapshot/restore round trips and hostile images that restore must reject
+// without writing anything
+#include "fs.hpp"
+#include "test.hpp"
+#include <cstdint>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+    // Image layout from image.cpp (shared with JS): a 32-byte header, 24-byte entries,
+    // NUL-terminated names and 8-byte aligned data, all little-endian uint32 fields
+    struct Item {
+        std::string name;
+        fs::EntryType type;
+        std::string data;
+        uint32_t mode = 0644;
+    };
+
+    void put32(std::vector<uint8_t>& image, size_t offset, uint32_t value) {
+        memcpy(image.data() + offset, &value, sizeof(value));
+    }
+
+    std::vector<uint8_t> build_image(const std::vector<Item>& items) {
+        const size_t names_offset = 32 + items.size() * 24;
+        size_t names_size = 0;
+        for (const Item& item : items) names_size += item.name.size() + 1;
+        const size_t data_offset = (names_offset + names_size + 7) & ~static_cast<size_t>(7);
+
+        std::vector<uint8_t> image(data_offset);
+        size_t name_cursor = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            const Item& item = items[i];
+            while (image.size() % 8) image.push_back(0);
+            const size_t entry = 32 + i * 24;
+            put32(image, entry, static_cast<uint32_t>(name_cursor));
+            put32(image, entry + 4, static_cast<uint32_t>(item.name.size()));
+            image[entry + 8] = static_cast<uint8_t>(item.type);
+            put32(image, entry + 12, item.mode);
+            put32(image, entry + 16, static_cast<uint32_t>(image.size() - data_offset));
+            put32(image, entry + 20, static_cast<uint32_t>(item.data.size()));
+            memcpy(image.data() + names_offset + name_cursor, item.name.c_str(), item.name.size() + 1);
+            name_cursor += item.name.size() + 1;
+            image.insert(image.end(), item.data.begin(), item.data.end());
+        }
+
+        const uint32_t header[8] = { 0x31534642, 1, static_cast<uint32_t>(items.size()), 24,
+                                     static_cast<uint32_t>(names_offset), static_cast<uint32_t>(data_offset),
+                                     static_cast<uint32_t>(image.size()), 0 };
+        memcpy(image.data(), header, sizeof(header));
+        return image;
+    }
+
+    int64_t restore(const std::vector<uint8_t>& image, const std::string& root) {
+        return fs::restore_tree(image.data(), image.size(), root.c_str());
+    }
+
+    bool exists(const std::string& path) {
+        struct stat st;
+        return lstat(path.c_str(), &st) == 0;
+    }
+
+    std::string contents(const std::string& path) {
+        std::string text;
+        return fs::read_all(path.c_str(), text) == 0 ? text : std::string("<unreadable>");
+    }
+
+    uint8_t* vector_alloc(size_t size, void* context) {
+        auto& image = *static_cast<std::vector<uint8_t>*>(context);
+        image.resize(size);
+        return image.data();
+    }
+
+    void test_round_trip(const test::TempDir& dir) {
+        const std::string source = dir / "source";
+        const std::vector<Item> items = {
+            { "a", fs::EntryType::Directory, "", 0755 },
+            { "a-file", fs::EntryType::File, "sorted between a and a/" },
+            { "a/b", fs::EntryType::Directory, "", 0700 },
+            { "a/b/c.txt", fs::EntryType::File, "nested" },
+            { "a/empty", fs::EntryType::File, "" },
+            { "link", fs::EntryType::Symlink, "a/b/c.txt", 0777 }
+        };
+        CHECK(restore(build_image(items), source) == 6);
+        CHECK_EQUAL(contents(source + "/a/b/c.txt"), "nested");
+        CHECK_EQUAL(contents(source + "/a-file"), "sorted between a and a/");
+        CHECK_EQUAL(contents(source + "/link"), "nested");
+
+        std::vector<uint8_t> image;
+        CHECK(fs::snapshot_tree(source.c_str(), vector_alloc, &image) > 0);
+        CHECK(image == build_image(items));
+
+        const std::string copy = dir / "copy";
+        CHECK(restore(image, copy) == 6);
+        CHECK_EQUAL(contents(copy + "/a/b/c.txt"), "nested");
+        struct stat st;
+        CHECK(lstat((copy + "/a/b").c_str(), &st) == 0 && (st.st_mode & 07777) == 0700);
+        char target[64] = {};
+        CHECK(readlink((copy + "/link").c_str(), target, sizeof(target) - 1) > 0);
+        CHECK_EQUAL(std::string_view(target), "a/b/c.txt");
+    }
+
+    // Every image here must fail and leave the root uncreated
+    void check_rejected(const test::TempDir& dir, const char* label, const std::vector<uint8_t>& image) {
+        const std::string root = dir / label;
+        if (restore(image, root) != -1) {
+            fprintf(stderr, "image '%s' was not rejected\n", label);
+            ++test::failures();
+        }
+        if (exists(root)) {
+            fprintf(stderr, "image '%s' wrote to the tree\n", label);
+            ++test::failures();
+        }
+    }
+
+    void test_hostile(const test::TempDir& dir) {
+        const std::string outside = dir / "outside";
+        CHECK(mkdir(outside.c_str(), 0755) == 0);
+
+        // A symlink out of the root, then an entry through it
+        check_rejected(dir, "symlink-ancestor", build_image({
+            { "link", fs::EntryType::Symlink, outside },
+            { "link/pwned", fs::EntryType::File, "escaped" }
+        }));
+        CHECK(!exists(outside + "/pwned"));
+
+        check_rejected(dir, "file-ancestor", build_image({
+            { "file", fs::EntryType::File, "x" },
+            { "file/child", fs::EntryType::File, "y" }
+        }));
+        check_rejected(dir, "missing-parent", build_image({
+            { "a/b", fs::EntryType::File, "x" }
+        }));
+        check_rejected(dir, "bad-type", build_image({
+            { "link", fs::EntryType::Symlink, outside },
+            { "z", static_cast<fs::EntryType>(9), "" }
+        }));
+        check_rejected(dir, "other-type", build_image({
+            { "fifo", fs::EntryType::Other, "" }
+        }));
+        check_rejected(dir, "duplicate", build_image({
+            { "a", fs::EntryType::File, "x" },
+            { "a", fs::EntryType::Symlink, outside }
+        }));
+        check_rejected(dir, "unsorted", build_image({
+            { "b", fs::EntryType::File, "x" },
+            { "a", fs::EntryType::File, "y" }
+        }));
+        for (const char* name : { "/abs", "../up", "a/../../up", "a//b", "./a", "a/" }) {
+            check_rejected(dir, "bad-name", build_image({
+                { "a", fs::EntryType::Directory, "" },
+                { name, fs::EntryType::File, "x" }
+            }));
+        }
+
+        // A count whose entry table size wraps a 32-bit size_t to names_offset
+        std::vector<uint8_t> wrapped = build_image({ { "a", fs::EntryType::File, "x" } });
+        const uint64_t wrap = (uint64_t(1) << 32) / 24 + 1;   // 24 * wrap == 2^32 + 8
+        put32(wrapped, 8, static_cast<uint32_t>(wrap));
+        put32(wrapped, 16, 32 + 8);
+        check_rejected(dir, "wrapped-count", wrapped);
+
+        std::vector<uint8_t> huge = build_image({ { "a", fs::EntryType::File, "x" } });
+        put32(huge, 8, UINT32_MAX);
+        check_rejected(dir, "huge-count", huge);
+
+        std::vector<uint8_t> truncated = build_image({ { "a", fs::EntryType::File, "some data" } });
+        truncated.resize(truncated.size() - 1);
+        check_rejected(dir, "truncated", truncated);
+    }
+
+    // A symlink already in the tree is replaced, not written through
+    void test_existing_symlink(const test::TempDir& dir) {
+        const std::string root = dir / "existing";
+        const std::string outside = dir / "outside2";
+        CHECK(mkdir(root.c_str(), 0755) == 0 && mkdir(outside.c_str(), 0755) == 0);
+        CHECK(symlink(outside.c_str(), (root + "/d").c_str()) == 0);
+        CHECK(symlink((outside + "/f").c_str(), (root + "/f").c_str()) == 0);
+
+        CHECK(restore(build_image({
+            { "d", fs::EntryType::Directory, "", 0755 },
+            { "d/inner", fs::EntryType::File, "in" },
+            { "f", fs::EntryType::File, "file" }
+        }), root) == 3);
+        CHECK(!exists(outside + "/inner") && !exists(outside + "/f"));
+        CHECK_EQUAL(contents(root + "/d/inner"), "in");
+        CHECK_EQUAL(contents(root + "/f"), "file");
+    }
+}
+
+int main() {
+    test::TempDir dir;
+    test_round_trip(dir);
+    test_hostile(dir);
+    test_existing_symlink(dir);
+    return test::failures();
+}
@@ -0,0 +1,93 @@
+// Change journal: folding of repeated events and incremental reads around it
+#include "fs.hpp"
+#include "test.hpp"
+#include <vector>
+
+namespace {
+    void write(const std::string& path, std::string_view text) {
+        CHECK(fs::write_bytes(path.c_str(), reinterpret_cast<const uint8_t*>(text.data()), text.size()) == 0);
+    }
+
+    std::vector<fs::ChangeEvent> changes_since(uint32_t since, uint32_t& last_seq) {
+        std::vector<fs::ChangeEvent> events;
+        CHECK(fs::read_changes(since, events, last_seq));
+        return events;
+    }
+
+    void test_folding(const test::TempDir& dir) {
+        const std::string file = dir / "folded";
+        uint32_t start;
+        changes_since(0, start);
+
+        // Unread repeats of the newest event fold into it
+        write(file, "a");
+        fs::write_bytes(file.c_str(), reinterpret_cast<const uint8_t*>("b"), 1, true);
+        write(file, "c");
+        uint32_t last;
+        std::vector<fs::ChangeEvent> events = changes_since(start, last);
+        CHECK(events.size() == 1);
+        CHECK(!events.empty() && events[0].path == file && events[0].op == fs::ChangeOp::Write);
+        CHECK(last == start + 1);
+
+        // A different op or path starts a new event
+        const std::string other = dir / "other";
+        write(other, "x");
+        write(file, "d");
+        CHECK(fs::remove_file(file.c_str()) == 0);
+        events = changes_since(last, last);
+        CHECK(events.size() == 3);
+        CHECK(events.size() == 3 && events[2].op == fs::ChangeOp::Remove);
+    }
+
+    void test_read_write_read(const test::TempDir& dir) {
+        const std::string file = dir / "reread";
+        uint32_t last;
+        changes_since(0, last);
+
+        write(file, "one");
+        std::vector<fs::ChangeEvent> events = changes_since(last, last);
+        CHECK(events.size() == 1);
+
+        // The event above was handed out, so this write must not fold into it
+        write(file, "two");
+        const uint32_t before = last;
+        events = changes_since(last, last);
+        CHECK(events.size() == 1);
+        CHECK(!events.empty() && events[0].path == file && events[0].seq == before + 1);
+
+        // Nothing new: an empty, complete read that keeps last_seq
+        events = changes_since(last, last);
+        CHECK(events.empty());
+        CHECK(last == before + 1);
+
+        // A seq from before a reload is ahead of the journal: incomplete, so rescan
+        std::vector<fs::ChangeEvent> ahead;
+        uint32_t ahead_last;
+        CHECK(!fs::read_changes(last + 100, ahead, ahead_last));
+        CHECK(ahead.empty() && ahead_last == last);
+    }
+
+    void test_overwritten(const test::TempDir& dir) {
+        uint32_t start;
+        changes_since(0, start);
+
+        // Alternate paths so nothing folds, then overflow the 4096-event ring
+        const std::string paths[] = { dir / "ring-a", dir / "ring-b" };
+        for (int i = 0; i < 5000; ++i) write(paths[i % 2], "r");
+
+        std::vector<fs::ChangeEvent> events;
+        uint32_t last;
+        CHECK(!fs::read_changes(start, events, last));
+        CHECK(last == start + 5000);
+        CHECK(events.size() == 4096);
+        CHECK(!events.empty() && events.front().seq == last - 4095 && events.back().seq == last);
+    }
+}
+
+int main() {
+    test::TempDir dir;
+    test_folding(dir);
+    test_read_write_read(dir);
+    test_overwritten(dir);
+    return test::failures();
+}
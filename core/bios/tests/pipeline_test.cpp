@@ -0,0 +1,172 @@
+// Command-line parsing: quoting, redirections, pipes and ; && || lists
+#include "commands.hpp"
+#include "fs.hpp"
+#include "test.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    commands::CommandResult run(const std::string& line) {
+        return commands::execute_command(line);
+    }
+
+    void test_quoting() {
+        CHECK_EQUAL(run("echo 'a  b'").output, "a  b");
+        CHECK_EQUAL(run("echo \"x | y\" ; echo '&& z'").output, "x | y&& z");
+        CHECK_EQUAL(run("echo pre'fix suf'fix").output, "prefix suffix");
+
+        // An empty quoted argument is an argument, not a missing one
+        commands::CommandResult empty = run("find ''");
+        CHECK(empty.code != 0);
+        CHECK(empty.output.rfind("Usage: find", 0) == 0);
+
+        commands::CommandResult result = run("echo 'open ; echo b");
+        CHECK(result.code != 0);
+        CHECK_EQUAL(result.output, "Syntax error: unterminated quote");
+    }
+
+    void test_redirection(const test::TempDir& dir) {
+        const std::string file = dir / "out.txt";
+        CHECK_EQUAL(run("echo first > " + file).output, "");
+        CHECK_EQUAL(run("echo second >> " + file).output, "");
+        CHECK_EQUAL(run("cat " + file).output, "firstsecond");
+
+        CHECK_EQUAL(run("echo again > " + file).output, "");
+        CHECK_EQUAL(run("cat < " + file).output, "again");
+
+        // Quoted targets may contain spaces and operators
+        const std::string spaced = dir / "a b|c.txt";
+        CHECK_EQUAL(run("echo spaced > '" + spaced + "'").output, "");
+        CHECK_EQUAL(run("cat < \"" + spaced + "\"").output, "spaced");
+
+        // Output and input on one stage
+        CHECK_EQUAL(run("cat < " + file + " > " + file + ".copy ; cat " + file + ".copy").output, "again");
+
+        commands::CommandResult missing = run("cat < " + (dir / "missing"));
+        CHECK(missing.code != 0);
+        CHECK_EQUAL(missing.output, "Failed to open file");
+
+        for (const char* line : { "echo a >", "echo a > ; echo b", "< in", "echo a | | cat", "echo a &&" }) {
+            commands::CommandResult result = run(line);
+            CHECK(result.code != 0);
+            CHECK(result.output.rfind("Syntax error", 0) == 0);
+        }
+        CHECK_EQUAL(run("echo a &").output, "Syntax error: background jobs (&) are not supported");
+    }
+
+    void test_pipes_and_lists(const test::TempDir& dir) {
+        const std::string file = dir / "lines.txt";
+        run("echo 'b error' > " + file);
+        CHECK_EQUAL(run("cat " + file + " | grep 'b error'").output, "b error\n");
+        CHECK_EQUAL(run("cat " + file + " | grep nothing").output, "");
+
+        // The error is not redirected into the file, like a shell's stderr
+        CHECK_EQUAL(run("cat " + (dir / "missing") + " > /dev/null || echo fallback").output, "Failed to open filefallback");
+        CHECK_EQUAL(run("echo one && echo two ; echo three;").output, "onetwothree");
+        CHECK(run("unknown-command && echo never").output.find("never") == std::string::npos);
+
+        // Piped input goes to the first pipeline only
+        commands::StringSink sink;
+        commands::CommandInput in;
+        in.data = "input";
+        in.piped = true;
+        commands::execute_command("cat ; echo ' next'", sink, in);
+        CHECK_EQUAL(sink.output, "input next");
+    }
+
+    // Stage data is not arena memory: piping and redirecting a large file leaves the
+    // scratch arena at the size of the small temporaries
+    void test_stage_buffers(const test::TempDir& dir) {
+        const std::string big = dir / "big.txt";
+        const std::string line(1023, 'x');
+        std::string text;
+        for (int i = 0; i < 4096; ++i) text.append(line).append("\n");
+        CHECK(fs::write_bytes(big.c_str(), reinterpret_cast<const uint8_t*>(text.data()), text.size()) == 0);
+
+        runtime::ScratchScope outer;
+        const size_t before = runtime::scratch_arena().used();
+        commands::StringSink sink;
+        commands::execute_command("cat < " + big + " | cat | grep -c x", sink);
+        CHECK_EQUAL(sink.output, "4096\n");
+        CHECK(runtime::scratch_arena().used() - before < 1024 * 1024);
+    }
+
+    // Keeps errors apart from output, as the WASI program's stdout/stderr do
+    class SplitSink : public commands::OutputSink {
+    public:
+        void write(std::string_view data) override { output.append(data); }
+        void error(std::string_view message) override { errors.append(message); }
+
+        std::string output;
+        std::string errors;
+    };
+
+    void test_errors(const test::TempDir& dir) {
+        const std::string file = dir / "errors.txt";
+        SplitSink unknown;
+        CHECK(commands::execute_command("nope", unknown) != 0);
+        CHECK_EQUAL(unknown.output, "");
+        CHECK_EQUAL(unknown.errors, "Unknown command");
+
+        // A failing middle stage, a redirect and a syntax error all report as errors
+        SplitSink piped;
+        commands::execute_command("cat " + (dir / "missing") + " | wc -l", piped);
+        CHECK_EQUAL(piped.output, "");
+        CHECK_EQUAL(piped.errors, "Failed to open file");
+
+        SplitSink redirected;
+        commands::execute_command("grep > " + file + " ; cat " + file, redirected);
+        CHECK_EQUAL(redirected.output, "");
+        CHECK(redirected.errors.rfind("Usage: grep", 0) == 0);
+
+        SplitSink syntax;
+        commands::execute_command("echo a |", syntax);
+        CHECK_EQUAL(syntax.output, "");
+        CHECK(syntax.errors.rfind("Syntax error", 0) == 0);
+    }
+
+    // An input source is only read by a command that reads its input
+    class CountingSource : public commands::InputSource {
+    public:
+        int64_t read(uint8_t* buffer, size_t cap) override {
+            ++reads;
+            if (remaining.empty() || cap == 0) return 0;
+            const size_t n = std::min(cap, remaining.size());
+            memcpy(buffer, remaining.data(), n);
+            remaining.remove_prefix(n);
+            return static_cast<int64_t>(n);
+        }
+
+        std::string_view remaining;
+        int reads = 0;
+    };
+
+    void test_input_source() {
+        CountingSource source;
+        source.remaining = "b error\nok\n";
+        commands::CommandInput in;
+        in.source = &source;
+        in.piped = true;
+
+        commands::StringSink skipped;
+        commands::execute_command("echo hi", skipped, in);
+        CHECK_EQUAL(skipped.output, "hi");
+        CHECK(source.reads == 0);
+
+        commands::StringSink sink;
+        commands::execute_command("grep error | cat", sink, in);
+        CHECK_EQUAL(sink.output, "b error\n");
+        CHECK(source.reads > 0 && source.remaining.empty());
+    }
+}
+
+int main() {
+    test::TempDir dir;
+    test_quoting();
+    test_redirection(dir);
+    test_pipes_and_lists(dir);
+    test_input_source();
+    test_errors(dir);
+    test_stage_buffers(dir);
+    return test::failures();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "fs.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+// Minimal checks for the native test programs: a failed CHECK reports itself and the
+// program's exit status is the number of failures
+namespace test {
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    inline void check(bool ok, const char* expr, const char* file, int line) {
+        if (ok) return;
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        ++failures();
+    }
+
+    inline void check_equal(std::string_view actual, std::string_view expected, const char* expr, const char* file, int line) {
+        if (actual == expected) return;
+        fprintf(stderr, "%s:%d: %s\n  expected: \"%.*s\"\n  actual:   \"%.*s\"\n", file, line, expr,
+            static_cast<int>(expected.size()), expected.data(), static_cast<int>(actual.size()), actual.data());
+        ++failures();
+    }
+
+    // A fresh directory under /tmp, removed when the scope ends
+    class TempDir {
+    public:
+        TempDir() {
+            char pattern[] = "/tmp/bios-test-XXXXXX";
+            if (!mkdtemp(pattern)) {
+                perror("mkdtemp");
+                exit(1);
+            }
+            path = pattern;
+        }
+
+        ~TempDir() { fs::remove_tree(path.c_str()); }
+
+        std::string operator/(std::string_view name) const { return path + '/' + std::string(name); }
+
+        std::string path;
+    };
+}
+
+#define CHECK(expr) test::check((expr), #expr, __FILE__, __LINE__)
+#define CHECK_EQUAL(actual, expected) test::check_equal((actual), (expected), #actual, __FILE__, __LINE__)
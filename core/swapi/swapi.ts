@@ -7,6 +7,7 @@ import { faker } from '@faker-js/faker'
 import pkg from './package.json'
 
 const CACHE_NAME = 'ecmaos-v1'
+const BIOS_CACHE_PREFIX = 'ecmaos-bios-'
 const SWAPI_BASE_PATH = '/swapi'
 
 const pendingFileRequests = new Map<string, {
@@ -106,7 +107,8 @@ self.addEventListener('activate', (event) => {
   event.waitUntil(
     (async () => {
       const cacheNames = await caches.keys()
-      const oldCaches = cacheNames.filter(name => name.startsWith('ecmaos-') && name !== CACHE_NAME)
+      // ecmaos-bios-* caches belong to the BIOS loader (@ecmaos/bios/loader), which prunes its own
+      const oldCaches = cacheNames.filter(name => name.startsWith('ecmaos-') && !name.startsWith(BIOS_CACHE_PREFIX) && name !== CACHE_NAME)
       
       await Promise.all(oldCaches.map(name => caches.delete(name)))
       
@@ -146,7 +148,9 @@ self.addEventListener('fetch', (event) => {
       const isStaticAsset = /\.(js|css|png|jpg|jpeg|gif|svg|ico|woff|woff2|ttf|eot|wasm)$/i.test(url.pathname)
       
       if (isStaticAsset) {
-        const cachedResponse = await cache.match(request)
+        // .wasm may already be in the BIOS loader's cache; serving that copy keeps V8's cached
+        // compiled code for it
+        const cachedResponse = await cache.match(request) ?? (url.pathname.endsWith('.wasm') ? await caches.match(request) : undefined)
         if (cachedResponse) return cachedResponse
         
         try {
@@ -22,3 +22,53 @@ export interface Telemetry {
   /** Whether telemetry is currently active */
   readonly active: boolean
 }
+
+/**
+ * Counters for one BIOS export or command
+ */
+export interface BIOSMetric {
+  /** Number of calls */
+  calls: number
+  /** Bytes passed in (command text, written data) */
+  bytesIn: number
+  /** Bytes produced (output, read data) */
+  bytesOut: number
+  /** Total wall time in milliseconds */
+  totalMs: number
+  /** Slowest single call in milliseconds */
+  maxMs: number
+  /** Latency histogram: bucket 0 is under 1us, bucket i covers [2^(i-1), 2^i) us */
+  latencyLog2Us: number[]
+}
+
+/**
+ * Snapshot returned by the BIOS get_metrics export
+ */
+export interface BIOSMetrics {
+  /** Metrics per BIOS export, keyed by export name */
+  exports: Record<string, BIOSMetric>
+  /** Metrics per BIOS command, keyed by command name */
+  commands: Record<string, BIOSMetric>
+  /** BIOS block cache counters */
+  blockCache: {
+    hits: number
+    misses: number
+    evictions: number
+    residentBytes: number
+    budget: number
+  }
+  /** BIOS dentry cache counters */
+  dentryCache: {
+    hits: number
+    misses: number
+    entries: number
+  }
+  /** BIOS content-addressed dedup counters */
+  dedup: {
+    blobs: number
+    references: number
+    storedBytes: number
+    logicalBytes: number
+    hits: number
+  }
+}